@@ -0,0 +1,113 @@
+#include <NTTEngine/dev/benchmark.hpp>
+#include <NTTEngine/core/profiling.hpp>
+#include <NTTEngine/core/formatter.hpp>
+#include <NTTEngine/core/parser/json.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+using namespace ntt;
+
+/**
+ * Run all registered benchmarks and write the results as JSON
+ *
+ * Arguments:
+ *      --filter=<text>     only the benchmarks whose names contain the text
+ *      --min-time=<ms>     the minimum measured time of each case (default 200)
+ *      --output=<path>     the JSON file (default: the standard output)
+ */
+int main(int argc, char **argv)
+{
+    ntt::ProfilingInit("profiling", TRUE);
+
+    String filter = "";
+    String output = "";
+    f64 minTime = 200.0;
+
+    for (i32 i = 1; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0)
+        {
+            filter = std::string(argv[i] + 9);
+        }
+        else if (std::strncmp(argv[i], "--min-time=", 11) == 0)
+        {
+            minTime = std::atof(argv[i] + 11);
+        }
+        else if (std::strncmp(argv[i], "--output=", 9) == 0)
+        {
+            output = std::string(argv[i] + 9);
+        }
+    }
+
+    List<JSON> results;
+
+    for (auto &benchmark : GetBenchmarks())
+    {
+        List<u32> arguments = benchmark.arguments;
+
+        if (arguments.empty())
+        {
+            arguments.push_back(0);
+        }
+
+        for (auto argument : arguments)
+        {
+            String name = benchmark.arguments.empty()
+                              ? benchmark.name
+                              : format("{}/{}", benchmark.name, argument);
+
+            if (filter != "" && name.FindFirst(filter) == String::NotFound)
+            {
+                continue;
+            }
+
+            Benchmark bench(argument, minTime);
+            benchmark.func(bench);
+
+            f64 itemsPerSecond = bench.GetAverageTime() > 0
+                                     ? bench.GetItemsCount() * 1000000000.0 / bench.GetAverageTime()
+                                     : 0;
+
+            std::fprintf(stderr,
+                         "%-40s %12.1f ns %12llu iterations %14.0f items/s\n",
+                         name.RawString().c_str(),
+                         bench.GetAverageTime(),
+                         static_cast<unsigned long long>(bench.GetIterations()),
+                         itemsPerSecond);
+
+            JSON result("{}");
+            result.Set<String>("name", name);
+            result.Set<u32>("argument", argument);
+            result.Set<u64>("iterations", bench.GetIterations());
+            result.Set<f64>("averageTime", bench.GetAverageTime());
+            result.Set<f64>("fastestTime", bench.GetFastestTime());
+            result.Set<f64>("slowestTime", bench.GetSlowestTime());
+            result.Set<f64>("itemsPerSecond", itemsPerSecond);
+            results.push_back(result);
+        }
+    }
+
+    JSON report("{}");
+#ifdef _DEBUG
+    report.Set<String>("build", "debug");
+#else
+    report.Set<String>("build", "release");
+#endif
+    report.Set<String>("timeUnit", "ns");
+    report.Set<f64>("minTime", minTime);
+    report.Set<JSON>("benchmarks", JSON::FromList(results));
+
+    if (output == "")
+    {
+        std::printf("%s\n", report.ToString().RawString().c_str());
+    }
+    else
+    {
+        std::ofstream file(output.RawString());
+        file << report.ToString().RawString() << std::endl;
+    }
+
+    return 0;
+}
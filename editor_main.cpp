@@ -18,6 +18,7 @@
 #include <NTTEngine/application/script_system/state_system.hpp>
 #include <NTTEngine/application/script_system/state_component.hpp>
 #include <NTTEngine/application/input_system/input_system.hpp>
+#include <NTTEngine/core/thread_pool.hpp>
 
 using namespace ntt;
 
@@ -60,57 +61,13 @@ int main(void)
     ResourceInit(TRUE);
     InputInit(FALSE, TRUE);
 
+    ThreadPoolInit();
     ECSInit();
 
-    // Parent system must be front of the render system for
-    //      child entity's position to be updated before rendering
-    ECSRegister(
-        "Parent System",
-        CreateRef<ParentSystem>(),
-        {typeid(Parent)},
-        TRUE);
-
-    ECSRegister(
-        "Render System",
-        CreateRef<RenderSystem>(TRUE),
-        {typeid(Geometry)},
-        TRUE);
-
-    ECSRegister(
-        "Editor System",
-        CreateRef<EditorSystem>(),
-        {typeid(Geometry)},
-        TRUE);
-
-    ECSRegister(
-        "Native Script System",
-        CreateRef<ScriptSystem>(),
-        {typeid(NativeScriptComponent)});
-
-    ECSRegister(
-        "State System",
-        CreateRef<StateSystem>(),
-        {typeid(StateComponent)});
-
-    ECSRegister(
-        COLLISION_NAME,
-        CreateRef<CollisionSystem>(),
-        {typeid(Geometry), typeid(Collision)});
-
-    ECSRegister(
-        "Hovering System",
-        CreateRef<MouseHoveringSystem>(),
-        {typeid(Hovering), typeid(Geometry)});
-
-    ECSRegister(
-        "Mass System",
-        CreateRef<MassSystem>(),
-        {typeid(Mass), typeid(Geometry)});
-
-    ECSRegister(
-        "Sprite Render System",
-        CreateRef<SpriteRenderSystem>(),
-        {typeid(Sprite), typeid(TextureComponent)});
+    RegisterEngineSystems(TRUE);
+
+    // the same physics rate as the game
+    ECSSetFixedStep(1000.0f / 60);
 
     s_timer.Reset();
     EditorInit(CurrentDirectory());
@@ -131,6 +88,7 @@ int main(void)
     EditorShutdown();
 
     ECSShutdown();
+    ThreadPoolShutdown();
 
     AudioShutdown();
     InputShutdown();
@@ -19,12 +19,17 @@
 #include <NTTEngine/platforms/path.hpp>
 #include <NTTEngine/editor/types.hpp>
 #include <NTTEngine/core/memory.hpp>
+#include <NTTEngine/core/thread_pool.hpp>
 
 using namespace ntt;
 
 void Update();
+b8 IsRunning();
 
 static Timer s_timer;
+static HeadlessOptions s_headless;
+static u32 s_frames = 0;
+static b8 s_headlessRunning = TRUE;
 static Scope<ProjectInfo> project;
 static Scope<SceneInfo> scene;
 static Scope<SceneInfo> menu;
@@ -32,7 +37,7 @@ String newScene = "";
 String menuSceneName = "";
 b8 isMenuOpen = FALSE;
 
-int main(void)
+int main(int argc, char **argv)
 {
     MemoryInit();
     LogInit();
@@ -68,62 +73,29 @@ int main(void)
         }
     }
 
-    SetTraceLogLevel(LOG_NONE);
-    InitWindow(project->width, project->height, "NTT Engine");
-    SetWindowTitle(project->title.RawString().c_str());
-    SetTargetFPS(60);
+    s_headless = ParseHeadlessOptions(argc, argv);
+
+    if (!s_headless.enabled)
+    {
+        SetTraceLogLevel(LOG_NONE);
+        InitWindow(project->width, project->height, "NTT Engine");
+        SetWindowTitle(project->title.RawString().c_str());
+        SetTargetFPS(60);
+    }
 
     ScriptStoreInit("CreateInstance", "DeleteInstance", "GetBaseType");
-    AudioInit();
-    RendererInit();
+    AudioInit(s_headless.enabled);
+    RendererInit(s_headless.enabled);
     ResourceInit(FALSE);
-    InputInit(FALSE, FALSE);
+    InputInit(s_headless.enabled, FALSE);
 
+    ThreadPoolInit();
     ECSInit();
 
-    // Parent system must be front of the render system for
-    //      child entity's position to be updated before rendering
-    ECSRegister(
-        "Parent System",
-        CreateRef<ParentSystem>(),
-        {typeid(Parent)},
-        TRUE);
-
-    ECSRegister(
-        "Render System",
-        CreateRef<RenderSystem>(FALSE),
-        {typeid(Geometry)},
-        TRUE);
-
-    ECSRegister(
-        "Native Script System",
-        CreateRef<ScriptSystem>(),
-        {typeid(NativeScriptComponent)});
-
-    ECSRegister(
-        "State System",
-        CreateRef<StateSystem>(),
-        {typeid(StateComponent)});
-
-    ECSRegister(
-        COLLISION_NAME,
-        CreateRef<CollisionSystem>(),
-        {typeid(Geometry), typeid(Collision)});
-
-    ECSRegister(
-        "Hovering System",
-        CreateRef<MouseHoveringSystem>(),
-        {typeid(Hovering), typeid(Geometry)});
-
-    ECSRegister(
-        "Mass System",
-        CreateRef<MassSystem>(),
-        {typeid(Mass), typeid(Geometry)});
-
-    ECSRegister(
-        "Sprite Render System",
-        CreateRef<SpriteRenderSystem>(),
-        {typeid(Sprite), typeid(TextureComponent)});
+    RegisterEngineSystems(FALSE);
+
+    // the physics is simulated at 60 ticks per second
+    ECSSetFixedStep(1000.0f / 60);
 
     ECSBeginLayer(GAME_LAYER);
     ECSBeginLayer(UI_LAYER);
@@ -165,7 +137,7 @@ int main(void)
 
     ProfilingBegin("Update");
     ChangeScene(project->defaultSceneName);
-    while (!WindowShouldClose())
+    while (IsRunning())
     {
         Update();
 
@@ -256,6 +228,7 @@ int main(void)
     }
 
     ECSShutdown();
+    ThreadPoolShutdown();
     ResourceUnload(project->defaultResources);
     project.reset();
 
@@ -270,7 +243,11 @@ int main(void)
     ScriptStoreShutdown();
     HotReloadShutdown();
 
-    CloseWindow();
+    if (!s_headless.enabled)
+    {
+        CloseWindow();
+    }
+
     NTT_ENGINE_DEBUG("Editor shutdown.");
 
     EventShutdown();
@@ -281,11 +258,27 @@ int main(void)
     return 0;
 }
 
+b8 IsRunning()
+{
+    if (s_headless.enabled)
+    {
+        return s_headlessRunning;
+    }
+
+    return !WindowShouldClose();
+}
+
 void Update()
 {
     auto delta = static_cast<f32>(s_timer.GetMilliseconds());
     s_timer.Reset();
 
+    if (s_headless.enabled)
+    {
+        s_headlessRunning = HeadlessStep(s_headless, s_frames, delta);
+        return;
+    }
+
     BeginDrawing();
     // ===================================================
     // code of the game loop below
@@ -30,6 +30,7 @@ namespace ntt
         resource_id_t GetScriptId() const;
         Ref<Script> GetObj();
         String GetName() const override;
+        Ref<ComponentBase> Clone() const override;
 
         JSON ToJSON() const override;
         void FromJSON(const JSON &j) override;
@@ -27,6 +27,8 @@ namespace ntt
 
         String GetName() const override;
 
+        Ref<ComponentBase> Clone() const override;
+
         JSON ToJSON() const override;
         void FromJSON(const JSON &json) override;
 
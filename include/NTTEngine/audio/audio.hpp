@@ -19,8 +19,11 @@ namespace ntt
     /**
      * Start the audio system. If not be called, other functions
      *      will call this function automatically.
+     *
+     * @param test: if TRUE, no audio device is opened (the headless mode),
+     *      the audios are loaded and played without any sound
      */
-    void AudioInit();
+    void AudioInit(b8 test = FALSE);
 
     /**
      * Load audio file from the given path (current support only
@@ -2,6 +2,8 @@
 #include <memory>
 #include <NTTEngine/defines.hpp>
 #include <functional>
+#include <atomic>
+#include <typeinfo>
 
 /**
  * The Memory module provides functionalities for dealing with
@@ -11,8 +13,14 @@
  *      - Scope pointer: The object can be owned by only 1 context.
  *      - Ref pointer: The object can be owned by multiple contexts.
  *
- * Provides the mechanism for checking memory leaks in the engine.
+ * Provides the mechanism for checking memory leaks in the engine, the
+ *      tracking is only compiled in the debug builds (can be turned off with
+ *      NTT_NO_MEMORY_TRACKING), the release builds pay nothing for it.
  */
+#if defined(_DEBUG) && !defined(NTT_NO_MEMORY_TRACKING)
+#define NTT_MEMORY_TRACKING
+#endif
+
 namespace ntt
 {
     /**
@@ -32,6 +40,51 @@ namespace ntt
      */
     void DeallocateCalled();
 
+    /**
+     * The number of the live Object instances (only counted when the memory
+     *      tracking is enabled, otherwise 0)
+     */
+    i32 MemoryGetLiveObjectsCount();
+
+    /**
+     * The live objects counter of a single type, the counters are never
+     *      destroyed so the objects which are released at the program exit
+     *      are still counted safely.
+     */
+    struct MemoryTypeCounter
+    {
+        const char *name;
+        std::atomic<i32> liveCount;
+    };
+
+    /**
+     * Create the counter of the type which is reported by MemoryShutdown,
+     *      should not be called directly (see MemoryCounterOf)
+     */
+    MemoryTypeCounter *MemoryRegisterType(const char *name);
+
+    template <typename T>
+    MemoryTypeCounter &MemoryCounterOf()
+    {
+        static MemoryTypeCounter *counter = MemoryRegisterType(typeid(T).name());
+        return *counter;
+    }
+
+    /**
+     * The number of the live objects of the type which are created with
+     *      CreateRef (or CreatePooledRef), only counted when the memory
+     *      tracking is enabled, otherwise 0
+     */
+    template <typename T>
+    i32 MemoryGetLiveCount()
+    {
+#ifdef NTT_MEMORY_TRACKING
+        return MemoryCounterOf<T>().liveCount.load();
+#else
+        return 0;
+#endif
+    }
+
     /**
      * The Scope pointer which can be owned by only 1 context,
      *      when the ownership of the object is moved, the object will be deleted
@@ -65,10 +118,21 @@ namespace ntt
      * @return The Ref pointer to the object
      */
     template <typename T, typename... Args>
-
-    constexpr Ref<T> CreateRef(Args &&...args)
+    Ref<T> CreateRef(Args &&...args)
     {
+#ifdef NTT_MEMORY_TRACKING
+        // the counter is decreased by the deleter, so the object is not
+        //      placed with its reference counter in the debug builds
+        T *object = new T(std::forward<Args>(args)...);
+        MemoryCounterOf<T>().liveCount++;
+
+        return Ref<T>(object, [](T *ptr)
+                      {
+                          MemoryCounterOf<T>().liveCount--;
+                          delete ptr; });
+#else
         return std::make_shared<T>(std::forward<Args>(args)...);
+#endif
     }
 
     /**
@@ -77,7 +141,7 @@ namespace ntt
     void MemoryShutdown();
 } // namespace ntt
 
-#ifdef _DEBUG
+#ifdef NTT_MEMORY_TRACKING
 #define CREATE_NEW() AllocateCalled()
 #define DELETE_OBJ() DeallocateCalled()
 #else
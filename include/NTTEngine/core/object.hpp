@@ -8,15 +8,24 @@ namespace ntt
      * Base object for all objects in the engine, every object (which is not a primitive type)
      *      must inherit from this class, this class will provide some basic functionalities
      *      for all objects in the engine
+     *
+     * The object has no data, it's only counted when the memory tracking is
+     *      enabled (see NTT_MEMORY_TRACKING), so it costs nothing in the
+     *      release builds.
      */
     class Object
     {
     public:
+#ifdef NTT_MEMORY_TRACKING
         Object();
+        Object(const Object &other);
         virtual ~Object();
+#else
+        Object() = default;
+        Object(const Object &other) = default;
+        virtual ~Object() = default;
+#endif
 
-    private:
-        class Impl;
-        Scope<Impl> m_impl;
+        Object &operator=(const Object &other) = default;
     };
 } // namespace ntt
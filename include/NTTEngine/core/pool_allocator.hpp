@@ -0,0 +1,174 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/core/memory.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <mutex>
+#include <cstddef>
+#include <new>
+
+/**
+ * Pool (slab) allocation for the small objects which are created and
+ *      destroyed in large numbers (components, entity records, script object
+ *      data, ...). Each type has its own pool of the fixed-size blocks, the
+ *      blocks are carved from the large slabs and the freed blocks are
+ *      reused, so creating an object is a pop from the free list rather
+ *      than a heap allocation.
+ *
+ * Usage:
+ *      Ref<Geometry> geo = CreatePooledRef<Geometry>(0, 0, 100, 100);
+ */
+namespace ntt
+{
+    /**
+     * The fixed-size block allocator, the slabs are only released when the
+     *      pool is destroyed. All functions are thread-safe.
+     */
+    class MemoryPool
+    {
+    public:
+        /**
+         * @param blockSize The size of each block (at least a pointer size)
+         * @param blockAlign The alignment of each block
+         * @param blocksPerSlab The number of blocks which are allocated at once
+         */
+        MemoryPool(u32 blockSize, u32 blockAlign, u32 blocksPerSlab = 256);
+        ~MemoryPool();
+
+        MemoryPool(const MemoryPool &) = delete;
+        MemoryPool &operator=(const MemoryPool &) = delete;
+
+        /**
+         * Retrieve a free block, a new slab is allocated when all the blocks
+         *      are used
+         */
+        void *Allocate();
+
+        /**
+         * Give the block back to the pool, the block must be allocated by
+         *      this pool
+         */
+        void Free(void *block);
+
+        /**
+         * The number of blocks which are allocated and not freed yet
+         */
+        u32 GetAllocatedCount();
+
+        /**
+         * The number of blocks of all slabs (allocated and free)
+         */
+        u32 GetCapacity();
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        void AllocateSlab();
+
+        u32 m_blockSize;
+        u32 m_blockAlign;
+        u32 m_blocksPerSlab;
+        u32 m_allocatedCount;
+        FreeBlock *m_freeList;
+        List<void *> m_slabs;
+        std::mutex m_mutex;
+    };
+
+    /**
+     * The pool of the type, it's created at the first usage and never
+     *      destroyed, so the objects which are released at the program exit
+     *      (static references) still have their pool.
+     */
+    template <typename T>
+    MemoryPool &PoolOf()
+    {
+        static MemoryPool *pool = new MemoryPool(sizeof(T), alignof(T));
+        return *pool;
+    }
+
+    /**
+     * The standard allocator over the type pools, the single objects are taken
+     *      from the pools and the arrays fall back to the heap.
+     */
+    template <typename T>
+    struct PoolAllocator
+    {
+        using value_type = T;
+
+        PoolAllocator() = default;
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U> &) {}
+
+        T *allocate(std::size_t n)
+        {
+            if (n == 1)
+            {
+                return static_cast<T *>(PoolOf<T>().Allocate());
+            }
+
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *ptr, std::size_t n)
+        {
+            if (n == 1)
+            {
+                PoolOf<T>().Free(ptr);
+                return;
+            }
+
+            ::operator delete(ptr);
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &) { return true; }
+
+    template <typename T, typename U>
+    bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &) { return false; }
+
+    /**
+     * The pooled version of CreateRef, the object and the reference counter
+     *      are placed in a single block of the pool.
+     *
+     * @param args The arguments to pass to the constructor of the object
+     * @return The Ref pointer to the object
+     */
+    template <typename T, typename... Args>
+    Ref<T> CreatePooledRef(Args &&...args)
+    {
+#ifdef NTT_MEMORY_TRACKING
+        // the object and the counter are in separate blocks since the deleter
+        //      must update the live objects counter of the type
+        void *block = PoolOf<T>().Allocate();
+        T *object = nullptr;
+
+        try
+        {
+            object = new (block) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            PoolOf<T>().Free(block);
+            throw;
+        }
+
+        MemoryCounterOf<T>().liveCount++;
+
+        return Ref<T>(
+            object,
+            [](T *ptr)
+            {
+                MemoryCounterOf<T>().liveCount--;
+                ptr->~T();
+                PoolOf<T>().Free(ptr);
+            },
+            PoolAllocator<T>());
+#else
+        return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+#endif
+    }
+} // namespace ntt
@@ -0,0 +1,54 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <functional>
+
+/**
+ * Fixed group of worker threads which is used by the engine for running
+ *      independent pieces of work (like the systems which touch different
+ *      components) at the same time.
+ *
+ * The pool is optional, if it is not initialized (or initialized with 0
+ *      workers) then all jobs are executed serially on the calling thread.
+ */
+namespace ntt
+{
+    using Job = std::function<void()>;
+
+    /**
+     * Start the worker threads.
+     *
+     * @param workersCount The number of worker threads, if 0 then the number
+     *      of hardware threads minus 1 (the calling thread also runs jobs) is used
+     */
+    void ThreadPoolInit(u32 workersCount = 0);
+
+    /**
+     * Retrieve the number of worker threads (not including the calling thread).
+     */
+    u32 ThreadPoolGetWorkersCount();
+
+    /**
+     * Run all the jobs and wait until all of them are finished. The calling
+     *      thread also takes jobs from the queue while waiting.
+     *
+     * The jobs must not throw, any escaped exception is logged and ignored.
+     */
+    void ThreadPoolRun(const List<Job> &jobs);
+
+    /**
+     * Queue a background job and return immediately, the workers take the
+     *      background jobs only when there is no job of ThreadPoolRun, so the
+     *      long jobs (like loading the files) do not block the frame. Without
+     *      workers the job is executed on the calling thread.
+     *
+     * The job must not throw, any escaped exception is logged and ignored.
+     */
+    void ThreadPoolSubmit(const Job &job);
+
+    /**
+     * Stop and join all the worker threads, the queued background jobs are
+     *      finished first.
+     */
+    void ThreadPoolShutdown();
+} // namespace ntt
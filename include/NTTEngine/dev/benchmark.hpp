@@ -0,0 +1,155 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/structures/string.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <chrono>
+#include <limits>
+
+/**
+ * The small benchmark harness of the engine, each benchmark is a function
+ *      which prepares its data and passes the measured body to Benchmark::Run.
+ *      The NTTEngine_Bench target runs all registered benchmarks (placed in
+ *      the __benchmarks__ folders) and writes the results as JSON, so the
+ *      results of two builds can be diffed.
+ *
+ * Usage:
+ *      NTT_BENCHMARK(CreateEntities, 100, 1000)
+ *      {
+ *          ECSInit();
+ *          bench.SetItemsCount(bench.Argument());
+ *          bench.Run([&]() { ... });
+ *          ECSShutdown();
+ *      }
+ */
+namespace ntt
+{
+    class Benchmark
+    {
+    public:
+        /**
+         * @param argument The size of the case (the number of entities, ...)
+         * @param minTime The body is repeated until this time is reached (milliseconds)
+         */
+        Benchmark(u32 argument, f64 minTime)
+            : m_argument(argument), m_minTime(minTime)
+        {
+        }
+
+        inline u32 Argument() const { return m_argument; }
+
+        /**
+         * The number of the items which are processed in one iteration of the
+         *      body, used for calculating the throughput
+         */
+        inline void SetItemsCount(u64 itemsCount) { m_itemsCount = itemsCount; }
+
+        /**
+         * Measure the body, it's called once for warming up, then in batches
+         *      which grow until a batch is long enough for the clock reads not
+         *      to affect the short bodies.
+         */
+        template <typename Func>
+        void Run(Func &&body)
+        {
+            using Clock = std::chrono::steady_clock;
+
+            body();
+
+            f64 minTime = m_minTime * 1000000.0;
+            u64 batch = 1;
+
+            m_iterations = 0;
+            m_totalTime = 0;
+            m_fastestTime = std::numeric_limits<f64>::max();
+            m_slowestTime = 0;
+
+            while (m_totalTime < minTime)
+            {
+                auto start = Clock::now();
+
+                for (u64 i = 0; i < batch; i++)
+                {
+                    body();
+                }
+
+                f64 time = std::chrono::duration<f64, std::nano>(Clock::now() - start).count();
+                f64 iterationTime = time / batch;
+
+                m_iterations += batch;
+                m_totalTime += time;
+                m_fastestTime = iterationTime < m_fastestTime ? iterationTime : m_fastestTime;
+                m_slowestTime = iterationTime > m_slowestTime ? iterationTime : m_slowestTime;
+
+                if (time < minTime / 50)
+                {
+                    batch *= 2;
+                }
+            }
+        }
+
+        inline u64 GetIterations() const { return m_iterations; }
+        inline u64 GetItemsCount() const { return m_itemsCount; }
+
+        /**
+         * The total time of all measured iterations (nanoseconds)
+         */
+        inline f64 GetTotalTime() const { return m_totalTime; }
+
+        /**
+         * The average time of one iteration (nanoseconds)
+         */
+        inline f64 GetAverageTime() const { return m_iterations == 0 ? 0 : m_totalTime / m_iterations; }
+
+        /**
+         * The average time of one iteration in the fastest/slowest batch (nanoseconds)
+         */
+        inline f64 GetFastestTime() const { return m_fastestTime; }
+        inline f64 GetSlowestTime() const { return m_slowestTime; }
+
+    private:
+        u32 m_argument;
+        f64 m_minTime;
+        u64 m_itemsCount = 1;
+
+        u64 m_iterations = 0;
+        f64 m_totalTime = 0;
+        f64 m_fastestTime = 0;
+        f64 m_slowestTime = 0;
+    };
+
+    using BenchmarkFunc = void (*)(Benchmark &bench);
+
+    struct BenchmarkCase
+    {
+        String name;
+        BenchmarkFunc func;
+        List<u32> arguments; ///< The function is run once for each argument
+    };
+
+    /**
+     * All benchmarks which are registered with NTT_BENCHMARK
+     */
+    inline List<BenchmarkCase> &GetBenchmarks()
+    {
+        static List<BenchmarkCase> benchmarks;
+        return benchmarks;
+    }
+
+    struct BenchmarkRegistrar
+    {
+        BenchmarkRegistrar(const char *name, BenchmarkFunc func, List<u32> arguments)
+        {
+            GetBenchmarks().push_back({name, func, arguments});
+        }
+    };
+} // namespace ntt
+
+/**
+ * Define and register a benchmark, the arguments (optional) are the sizes of
+ *      the cases, the body receives the `Benchmark &bench` parameter
+ */
+#define NTT_BENCHMARK(name, ...)                                    \
+    static void NTTBenchmark_##name(ntt::Benchmark &bench);         \
+    static ntt::BenchmarkRegistrar s_benchmarkRegistrar_##name(     \
+        #name, NTTBenchmark_##name, ntt::List<u32>{__VA_ARGS__});   \
+    static void NTTBenchmark_##name(ntt::Benchmark &bench)
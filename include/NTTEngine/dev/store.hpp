@@ -1,9 +1,11 @@
 #pragma once
 #include "dev.hpp"
 #include <functional>
+#include <deque>
+#include <unordered_map>
 #include <NTTEngine/structures/list.hpp>
-#include <NTTEngine/structures/sorted_list.hpp>
 #include <NTTEngine/structures/dictionary.hpp>
+#include <NTTEngine/structures/string.hpp>
 #include <NTTEngine/core/logging/logging.hpp>
 #include <NTTEngine/core/assertion.hpp>
 
@@ -22,25 +24,43 @@ namespace ntt
      * Provide a generic way to storing resources
      *      object in the engine.
      *
+     * The store is a slot map, the objects are placed in the slots which are
+     *      indexed by their ids and the ids of the stored objects are kept
+     *      in a dense list, so adding, removing and querying are O(1) and
+     *      the iteration never touches the empty slots. The order of the
+     *      dense list is not the order of the ids (the removed id is
+     *      replaced by the last one).
+     *
      * @tparam id_t The type of the id used to identify the object.
      * @tparam data_t The type of the object to store. The data inside
      *      this object must be able to be deleted automatically when the
      *      object is removed from the store (prefer using Scope<> rather than Ref<>).
-     * @tparam unique_field_t The additional field to ensure the uniqueness of the object.
-     *      (ex: a file should only be loaded once)
+     * @tparam key_t The type of the key field which can be indexed
+     *      (ex: the path of a file, the name of a system)
      */
-    template <typename id_t, typename data_t>
+    template <typename id_t, typename data_t, typename key_t = String>
     class Store
     {
     public:
+        /**
+         * @param compareFunc Used to ensure the uniqueness of the object (ex: a
+         *      file should only be loaded once), nullptr if the objects are
+         *      never considered as the same. Without the key index, checking
+         *      the uniqueness needs a scan over all the objects.
+         * @param getKey The key field of the object, when it's provided the
+         *      objects are indexed by this field (see GetIdsByKey) and only
+         *      the objects with the same key are compared with compareFunc.
+         *      The key must not be changed while the object is stored.
+         */
         Store(
             id_t defaultId,
             id_t maxElement,
             CompareFunc<data_t> compareFunc = [](Ref<data_t> a, Ref<data_t> b)
-            { return *a == *b; })
+            { return *a == *b; },
+            GetFieldFunc<data_t, key_t> getKey = nullptr)
             : m_defaultId(defaultId), m_currentId(defaultId),
-              m_max(maxElement), m_compareFunc(compareFunc),
-              m_store({}), m_freedIds()
+              m_max(maxElement), m_compareFunc(compareFunc), m_getKey(getKey),
+              m_store({}), m_denseIndex({}), m_dense({}), m_freedIds(), m_index()
         {
             NTT_ENGINE_TRACE("The store is created");
         }
@@ -48,7 +68,9 @@ namespace ntt
         ~Store()
         {
             m_store.clear();
+            m_dense.clear();
             m_freedIds.clear();
+            m_index.clear();
             NTT_ENGINE_TRACE("The store is deleted");
         }
 
@@ -59,75 +81,118 @@ namespace ntt
          */
         id_t Add(Ref<data_t> data)
         {
-            if (m_store.size() >= m_max)
-            {
-                NTT_ENGINE_TRACE("The store is full, cannot add more elements");
-                return m_defaultId;
-            }
+            id_t existedId = m_defaultId;
 
-            if (Contains(data))
+            if (Find(data, existedId))
             {
                 NTT_ENGINE_TRACE("The object is already stored in the store");
+                return existedId;
+            }
 
-                auto availableIds = GetAvailableIds();
-
-                for (auto id : availableIds)
-                {
-                    if (m_compareFunc(data, m_store[id]))
-                    {
-                        return id;
-                    }
-                }
+            if (m_dense.size() >= m_max)
+            {
+                NTT_ENGINE_TRACE("The store is full, cannot add more elements");
                 return m_defaultId;
             }
 
+            id_t id;
+
             if (m_freedIds.size() > 0)
             {
-                auto id = m_freedIds[0];
-                m_store[id] = data;
-                m_freedIds.Remove(0);
-
-                return id;
+                id = m_freedIds.front();
+                m_freedIds.pop_front();
+                m_store[SlotOf(id)] = data;
             }
             else
             {
+                id = m_currentId++;
                 m_store.push_back(data);
-                return m_currentId++;
+                m_denseIndex.push_back(0);
+            }
+
+            m_denseIndex[SlotOf(id)] = m_dense.size();
+            m_dense.push_back(id);
+
+            if (m_getKey != nullptr)
+            {
+                m_index[m_getKey(data)].push_back(id);
+            }
+
+            return id;
+        }
+
+        /**
+         * The ids of the objects which have the given key (see the getKey of
+         *      the constructor), the store must be created with the key index.
+         */
+        const List<id_t> &GetIdsByKey(const key_t &key) const
+        {
+            static const List<id_t> empty = {};
+
+            ASSERT_M(m_getKey != nullptr, "The store is created without the key index");
+
+            auto it = m_index.find(key);
+
+            if (it == m_index.end())
+            {
+                return empty;
+            }
+
+            return it->second;
+        }
+
+        /**
+         * Query the first object which has the given key, nullptr if there
+         *      is no object with the key.
+         */
+        Ref<data_t> GetByKey(const key_t &key)
+        {
+            auto &ids = GetIdsByKey(key);
+
+            if (ids.empty())
+            {
+                return nullptr;
             }
+
+            return Get(ids[0]);
         }
 
         /**
          * Query the object which has the field value which
-         *      matches the given value.
+         *      matches the given value. All objects are scanned, prefer
+         *      GetIdsByKey for the indexed field.
          */
         template <typename field_t>
         List<Ref<data_t>> GetByField(field_t value, GetFieldFunc<data_t, field_t> getField)
         {
             List<Ref<data_t>> result = {};
-            auto availableIds = GetAvailableIds();
 
-            for (auto id : availableIds)
+            for (auto id : m_dense)
             {
-                if (getField(Get(id)) == value)
+                auto data = m_store[SlotOf(id)];
+
+                if (getField(data) == value)
                 {
-                    result.push_back(Get(id));
+                    result.push_back(data);
                 }
             }
 
             return result;
         }
 
+        /**
+         * The ids version of GetByField (all objects are scanned as well)
+         */
         template <typename field_t>
         List<id_t> GetIdsByField(field_t value, GetFieldFunc<data_t, field_t> getField)
         {
             List<id_t> ids = {};
-            auto availableIds = GetAvailableIds();
 
-            for (auto i = 0; i < availableIds.size(); i++)
+            for (auto id : m_dense)
             {
-                if (getField(Get(availableIds[i])) == value)
+                if (getField(m_store[SlotOf(id)]) == value)
                 {
-                    ids.push_back(availableIds[i]);
+                    ids.push_back(id);
                 }
             }
 
@@ -146,7 +211,7 @@ namespace ntt
                 return nullptr;
             }
 
-            return m_store[id];
+            return m_store[SlotOf(id)];
         }
 
         /**
@@ -159,7 +224,7 @@ namespace ntt
                 return FALSE;
             }
 
-            if (m_store[id] == nullptr)
+            if (m_store[SlotOf(id)] == nullptr)
             {
                 return FALSE;
             }
@@ -172,15 +237,8 @@ namespace ntt
          */
         u8 Contains(Ref<data_t> data)
         {
-            for (auto i = 0; i < m_currentId; i++)
-            {
-                if (m_store[i] != nullptr && m_compareFunc(data, m_store[i]))
-                {
-                    return TRUE;
-                }
-            }
-
-            return FALSE;
+            id_t id;
+            return Find(data, id);
         }
 
         /**
@@ -192,53 +250,72 @@ namespace ntt
         {
             auto data = Get(id);
 
-            if (data != nullptr)
+            if (data == nullptr)
             {
-                m_store[id] = nullptr;
-                // data.reset();
+                return;
+            }
 
-                // ASSERT_M(data == nullptr, "The object is not deleted properly");
+            if (m_getKey != nullptr)
+            {
+                auto it = m_index.find(m_getKey(data));
 
-                // for (auto i = 0; i < m_freedIds.size(); i++)
-                // {
-                //     if (m_freedIds[i] > id)
-                //     {
-                //         m_freedIds.Add(i, id);
-                //         return;
-                //     }
-                // }
+                if (it != m_index.end())
+                {
+                    it->second.RemoveItem(id);
 
-                // m_freedIds.push_back(id);
-                m_freedIds.Add(id);
+                    if (it->second.empty())
+                    {
+                        m_index.erase(it);
+                    }
+                }
             }
+
+            // the last id takes the place of the removed one
+            u32 denseIndex = m_denseIndex[SlotOf(id)];
+            id_t lastId = m_dense.back();
+            m_dense[denseIndex] = lastId;
+            m_denseIndex[SlotOf(lastId)] = denseIndex;
+            m_dense.pop_back();
+
+            m_store[SlotOf(id)] = nullptr;
+
+            // the freed ids are reused in the releasing order (O(1))
+            m_freedIds.push_back(id);
         }
 
         /**
-         * Get all ids which their objects are currently stored.
+         * Get all ids which their objects are currently stored, the list is
+         *      owned by the store (copy it before releasing the objects while
+         *      iterating).
          */
-        List<id_t> GetAvailableIds()
+        const List<id_t> &GetAvailableIds() const
         {
-            List<id_t> availableIds = {};
-            for (id_t i = 0; i < m_currentId; i++)
-            {
-                if (m_store[i] != nullptr)
-                {
-                    availableIds.push_back(i);
-                }
-            }
-            return availableIds;
+            return m_dense;
+        }
+
+        /**
+         * The number of the stored objects.
+         */
+        u32 Count() const
+        {
+            return m_dense.size();
         }
 
         /**
          * Functions which will be called for each active object in the store.
+         *      The function can release the object which it receives.
          */
         void ForEach(ForEachFunc<id_t, data_t> func)
         {
-            for (auto i = 0; i < m_currentId; i++)
+            for (u32 i = 0; i < m_dense.size();)
             {
-                if (m_store[i] != nullptr)
+                id_t id = m_dense[i];
+                func(m_store[SlotOf(id)], id);
+
+                // the current object is released, the next one is moved here
+                if (i < m_dense.size() && m_dense[i] == id)
                 {
-                    func(m_store[i], i);
+                    i++;
                 }
             }
         }
@@ -247,8 +324,61 @@ namespace ntt
         id_t m_defaultId;
         id_t m_currentId;
         id_t m_max;
-        List<Ref<data_t>> m_store;
         CompareFunc<data_t> m_compareFunc;
-        SortedList<id_t> m_freedIds;
+        GetFieldFunc<data_t, key_t> m_getKey;
+
+        List<Ref<data_t>> m_store; ///< The objects indexed by their slots
+        List<u32> m_denseIndex;    ///< The position of each slot in m_dense
+        List<id_t> m_dense;        ///< The ids of the stored objects
+        std::deque<id_t> m_freedIds;
+        std::unordered_map<key_t, List<id_t>> m_index;
+
+        inline u32 SlotOf(id_t id) const
+        {
+            return id - m_defaultId;
+        }
+
+        inline b8 IsSame(Ref<data_t> data, id_t id)
+        {
+            return m_compareFunc != nullptr && m_compareFunc(data, m_store[SlotOf(id)]);
+        }
+
+        /**
+         * Find the stored object which is the same as the data (based on the
+         *      compare function), only the objects with the same key are
+         *      checked when the store has the key index.
+         */
+        b8 Find(Ref<data_t> data, id_t &result)
+        {
+            if (m_compareFunc == nullptr)
+            {
+                return FALSE;
+            }
+
+            const List<id_t> *candidates = &m_dense;
+
+            if (m_getKey != nullptr)
+            {
+                auto it = m_index.find(m_getKey(data));
+
+                if (it == m_index.end())
+                {
+                    return FALSE;
+                }
+
+                candidates = &it->second;
+            }
+
+            for (auto id : *candidates)
+            {
+                if (IsSame(data, id))
+                {
+                    result = id;
+                    return TRUE;
+                }
+            }
+
+            return FALSE;
+        }
     };
 } // namespace ntt
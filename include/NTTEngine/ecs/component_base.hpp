@@ -1,6 +1,7 @@
 #pragma once
 #include <NTTEngine/defines.hpp>
 #include <NTTEngine/core/memory.hpp>
+#include <NTTEngine/core/pool_allocator.hpp>
 #include <NTTEngine/structures/list.hpp>
 #include <NTTEngine/core/parser/json.hpp>
 #include <NTTEngine/structures/dictionary.hpp>
@@ -20,6 +21,34 @@ namespace ntt
     // constexpr entity_id_t INVALID_ENTITY_ID =
     constexpr entity_id_t INVALID_ENTITY_ID = -1;
 
+    /**
+     * The entity ID is split into the slot index (low bits) and the generation
+     *      of the slot (high bits). Each time the slot is released, its
+     *      generation is increased, so an old ID of a deleted entity never
+     *      refers to the new entity which reuses the same slot.
+     */
+#define ENTITY_INDEX_BITS 20
+#define ENTITY_INDEX_MASK ((1u << ENTITY_INDEX_BITS) - 1)
+#define ENTITY_GENERATION_MASK ((1u << (32 - ENTITY_INDEX_BITS)) - 1)
+#define MAX_ENTITIES ENTITY_INDEX_MASK ///< The last index is kept for INVALID_ENTITY_ID
+
+    inline u32 EntityIndex(entity_id_t id) { return id & ENTITY_INDEX_MASK; }
+    inline u32 EntityGeneration(entity_id_t id) { return id >> ENTITY_INDEX_BITS; }
+    inline entity_id_t MakeEntityId(u32 index, u32 generation)
+    {
+        return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) |
+               (index & ENTITY_INDEX_MASK);
+    }
+
+    /**
+     * Used with the SparseSet for indexing the entities by their slot index
+     *      rather than the whole ID (which can be a large number)
+     */
+    struct EntityIndexOf
+    {
+        static u32 Get(entity_id_t id) { return EntityIndex(id); }
+    };
+
     /**
      * Component Base contains only the data, no logic, so the struct is used
      *      rather than class. Other component should inherit from this struct.
@@ -31,6 +60,21 @@ namespace ntt
         b8 active = TRUE;
 
         virtual String GetName() const = 0;
+
+        /**
+         * Create a new component with the same data (used by the prefabs and
+         *      the entity duplication). The runtime state which belongs to a
+         *      single entity (script objects, ...) is not copied. If the
+         *      component does not support cloning, then return nullptr.
+         */
+        virtual Ref<ComponentBase> Clone() const { return nullptr; }
+
+        /**
+         * Update the IDs of the other entities which are kept by the component
+         *      when these entities are re-created with the new IDs (see
+         *      ECSRestore), the dictionary maps the old IDs into the new ones.
+         */
+        virtual void RemapEntities(const Dictionary<entity_id_t, entity_id_t> &ids) {}
         virtual JSON ToJSON() const { return JSON("{}"); }
         virtual void FromJSON(const JSON &json) {}
         virtual void TurnOff() { active = FALSE; }
@@ -19,5 +19,10 @@ namespace ntt
         {
             return "DataComponent";
         }
+
+        Ref<ComponentBase> Clone() const override
+        {
+            return CreatePooledRef<DataComponent>(*this);
+        }
     };
 } // namespace ntt
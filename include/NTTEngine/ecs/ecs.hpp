@@ -6,11 +6,16 @@
 #include "entity_info.hpp"
 #include "system.hpp"
 #include "layer_types.hpp"
+#include "ecs_query.hpp"
+#include "prefab.hpp"
+#include "snapshot.hpp"
+#include "ecs_stats.hpp"
 
 /**
  * Manage all the entity inside the game. This module has 3 main components:
  *      - Entity: The object in the world and is defined by a unique ID and
- *          contains a list of components.
+ *          contains a list of components. The entities which have the same
+ *          set of components are stored together in an archetype.
  *      - Component: The group of generic data that can be attached to any
  *          entity. The component contains the data only, no logic.
  *      - System: The Updatable system will automatically received the needed
@@ -28,15 +33,66 @@ namespace ntt
      * Add new system to the ECS, the order of adding the system is the order
      *      of the system will be updated.
      *
+     * When the system declares its accessed components, it can be updated
+     *      at the same time with other declared systems on the worker threads
+     *      (see `ThreadPoolInit`) if they do not conflict (one writes the
+     *      component which the other reads or writes). The conflicted systems
+     *      are always updated in the registration order.
+     *
      * @param name The name of the system, use for debugging only
      * @param system The system to be added to the ECS
      * @param componentTypes The list of component types that the system needs
      * @param runInDebug If the system is running in the debug mode or not
+     * @param access The components which are read/written by the system, if
+     *      nothing is declared, then the system is updated alone
+     * @param fixedStep The system is a simulation system which is updated with
+     *      the constant delta of the fixed step (see `ECSSetFixedStep`), the
+     *      fixed steps are run at the place of the first fixed system, so
+     *      the systems which are registered before it are updated before
+     *      the fixed steps and the others after them
      */
     void ECSRegister(String name,
                      Ref<System> system,
                      List<std::type_index> componentTypes,
-                     b8 alwayUpdate = FALSE);
+                     b8 alwayUpdate = FALSE,
+                     const SystemAccess &access = SystemAccess(),
+                     b8 fixedStep = FALSE);
+
+#define ECS_MAX_FIXED_STEPS 5 ///< The default maximum number of the fixed steps in one frame
+
+    /**
+     * Update the fixed systems at a constant rate, the frame delta is
+     *      accumulated and the fixed systems are updated once for each
+     *      complete step (zero or several times per frame), so the simulation
+     *      does not depend on the frame rate. The Geometry of the entities
+     *      in the fixed systems is interpolated between the last two steps
+     *      when it's drawn (see `Geometry::GetDrawnPos`).
+     *
+     * @param stepTime The delta of each step (milliseconds), 0 disables the
+     *      fixed step (the fixed systems are updated once per frame with the
+     *      frame delta, in the registration order), it's the default
+     * @param maxSteps The maximum number of steps in one frame, the remaining
+     *      time is dropped so a slow frame does not make the next ones slower
+     */
+    void ECSSetFixedStep(f32 stepTime, u32 maxSteps = ECS_MAX_FIXED_STEPS);
+
+    /**
+     * Check whether the fixed systems are updated at a constant rate or not
+     */
+    b8 ECSIsFixedStepEnabled();
+
+    /**
+     * The index of the last fixed step (increased before each step), 0 if
+     *      no step has been run
+     */
+    u32 ECSGetFixedStepIndex();
+
+    /**
+     * The progress (from 0 to 1) from the last fixed step to the next one, it's
+     *      used for interpolating the drawn states, 1 if the fixed step is
+     *      disabled
+     */
+    f32 ECSGetFixedStepAlpha();
 
     /**
      * Change the state of the system, if the system is not active, then
@@ -86,6 +142,10 @@ namespace ntt
 
     /**
      * Clear all the entities inside the layer and remove the layer from the system.
+     *      The entities are deleted right away even inside ECSUpdate, and
+     *      the recorded changes of them are dropped. Inside a query the layer
+     *      is cleared when the outermost query is finished (the visited rows
+     *      must not be removed), with the entities created there meanwhile.
      *
      * @param layer The layer to be cleared
      *      if the layer is not found, then nothing will be changed
@@ -121,6 +181,13 @@ namespace ntt
      * When a new entity is created with attached components, the entity will
      *      be passed to the system which needs the components.
      *
+     * If the entity is created while the systems are updated (inside ECSUpdate),
+     *      the components are available right away but the entity is only
+     *      passed to the systems (and added to the layer) at the end of the frame.
+     *      The entity which is created by a declared system (updated on the
+     *      worker threads) only has its ID reserved, its components are only
+     *      available at the end of the frame as well.
+     *
      * @param name The name of the entity (use for debugging only)
      * @param components The list of components to be attached to the entity
      *
@@ -131,12 +198,40 @@ namespace ntt
         const String &name,
         Dictionary<std::type_index, Ref<ComponentBase>> components);
 
+    /**
+     * Create many entities at once (ex: loading a scene). The archetype and
+     *      the matched systems are resolved once per distinct set of
+     *      components, the storage is reserved once, and all the entities are
+     *      added to their systems before any InitEntity is called.
+     *
+     * The components of the given entity infos are attached to the new
+     *      entities as is (they are shared, not copied). Inside ECSUpdate the
+     *      entities are deferred the same way as `ECSCreateEntity`.
+     *
+     * @param entities The name and the components of each entity
+     *
+     * @return The ID of each created entity in the same order, the failed
+     *      entity has the INVALID_ENTITY_ID
+     */
+    List<entity_id_t> ECSCreateEntities(Span<const Ref<EntityInfo>> entities);
+
     /**
      * Retreive the entity information based on the entity ID.
      * If the entity is not found, then return nullptr
+     *
+     * The components are gathered from the archetype storage, so adding or
+     *      removing the components of the returned dictionary does not
+     *      affect the entity (the component objects themselves are shared).
+     *      All the components are marked as changed.
      */
     Ref<EntityInfo> ECSGetEntity(entity_id_t id);
 
+    /**
+     * Check whether the entity with the given ID is still existed (created
+     *      and not deleted yet).
+     */
+    b8 ECSIsEntityValid(entity_id_t id);
+
     /**
      * Retreive the entity id based on the name of the entity.
      * The name is case-sensitive and be the name which is generated
@@ -156,8 +251,51 @@ namespace ntt
     /**
      * Retrieve the component with the certain type from the entity.
      * If the entity is not found, then return nullptr
+     *
+     * Since the returned component can be modified, it's marked as changed
+     *      (see ECSIsComponentChanged) unless `markChanged` is FALSE, use
+     *      ECS_READ_COMPONENT for the read-only access. The systems must use
+     *      ECS_READ_COMPONENT for the types declared in SystemAccess::reads,
+     *      the components of those types are never marked by the system
+     *      (it may run at the same time with the other readers).
+     */
+    Ref<ComponentBase> ECSGetEntityComponent(entity_id_t id,
+                                             std::type_index type,
+                                             b8 markChanged = TRUE);
+
+    /**
+     * Mark the component of the entity as changed. It's only needed when the
+     *      component is modified through a reference which is kept from
+     *      the earlier frames (the fetching functions already mark it).
+     */
+    void ECSMarkComponentChanged(entity_id_t id, std::type_index type);
+
+    /**
+     * Check whether the component of the entity is changed (or added) after
+     *      the given tick, by default it's the last update of the currently
+     *      running system, outside of any system all components are
+     *      considered as changed.
+     *
+     * The changes which are made by the running system itself during its
+     *      previous update are not counted with the default tick.
+     */
+    b8 ECSIsComponentChanged(entity_id_t id,
+                             std::type_index type,
+                             u32 since = QUERY_SINCE_LAST_RUN);
+
+    /**
+     * Check whether the component is added to the entity after the given
+     *      tick (see ECSIsComponentChanged).
      */
-    Ref<ComponentBase> ECSGetEntityComponent(entity_id_t id, std::type_index type);
+    b8 ECSIsComponentAdded(entity_id_t id,
+                           std::type_index type,
+                           u32 since = QUERY_SINCE_LAST_RUN);
+
+    /**
+     * The change tick of the previous update of the currently running
+     *      system, 0 if it's called outside of any system.
+     */
+    u32 ECSGetLastRunTick();
 
     /**
      * Changing the state of the component, if the component is not active,
@@ -166,15 +304,51 @@ namespace ntt
      * If the id or the component type is not found, then nothing will be changed
      *      the warning will be logged.
      *
+     * The state of the component is changed immediately, but if this function
+     *      is called inside ECSUpdate, the systems only see the change at the
+     *      end of the frame.
+     *
      * @param id The ID of the entity
      * @param type The type of the component
      * @param active The state of the component
      */
     void ECSSetComponentActive(entity_id_t id, std::type_index type, b8 active = TRUE);
 
+    /**
+     * Attach the new component to the existed entity, the entity is moved to
+     *      the storage of its new set of components (the other components
+     *      are moved as is). Only the systems which need the new component
+     *      are affected, they receive the entity (and InitEntity is called)
+     *      if all of their components are active.
+     *
+     * If the entity already has the component, then nothing will be changed
+     *      and the warning will be logged. Inside ECSUpdate (or a query), the
+     *      component is only attached at the end of the frame.
+     *
+     * @param id The ID of the entity
+     * @param type The type of the component
+     * @param component The component which is attached
+     */
+    void ECSAddComponent(entity_id_t id, std::type_index type, Ref<ComponentBase> component);
+
+    /**
+     * Detach the component from the entity, only the systems which need the
+     *      component are affected (ShutdownEntity is called before the
+     *      component is removed). The DataComponent cannot be removed.
+     *
+     * Inside ECSUpdate (or a query), the component is only removed at the end
+     *      of the frame.
+     *
+     * @param id The ID of the entity
+     * @param type The type of the component
+     */
+    void ECSRemoveComponent(entity_id_t id, std::type_index type);
+
     /**
      * Delete the entity and all the components attached to the entity.
-     *      The enity is removed at the end of the frame.
+     *      If this function is called inside ECSUpdate, the entity is removed
+     *      at the end of the frame (ECSIsEntityValid returns FALSE right away),
+     *      otherwise it is removed immediately.
      *
      * @param id The ID of the entity to be deleted
      *      if the id is invalid, then nothing will be deleted
@@ -185,6 +359,10 @@ namespace ntt
     /**
      * Update the ECS system. This function must be called every frame for
      *      having updated for each registered system.
+     *
+     * All the entity creations, deletions, component state changes and
+     *      component additions/removals which are requested by the systems
+     *      are applied in order after all the systems are updated.
      */
     void ECSUpdate(f32 delta);
 
@@ -197,4 +375,11 @@ namespace ntt
 
 #define ECS_GET_COMPONENT(id, type) std::static_pointer_cast<type>( \
     ECSGetEntityComponent(id, typeid(type)))
-#define ECS_CREATE_COMPONENT(type, ...) {typeid(type), std::make_shared<type>(__VA_ARGS__)}
\ No newline at end of file
+#define ECS_READ_COMPONENT(id, type) std::static_pointer_cast<const type>( \
+    ECSGetEntityComponent(id, typeid(type), FALSE))
+#define ECS_MARK_CHANGED(id, type) ECSMarkComponentChanged(id, typeid(type))
+#define ECS_IS_CHANGED(id, type) ECSIsComponentChanged(id, typeid(type))
+#define ECS_IS_ADDED(id, type) ECSIsComponentAdded(id, typeid(type))
+#define ECS_CREATE_COMPONENT(type, ...) {typeid(type), CreatePooledRef<type>(__VA_ARGS__)}
+#define ECS_ADD_COMPONENT(id, type, ...) ECSAddComponent(id, typeid(type), CreatePooledRef<type>(__VA_ARGS__))
+#define ECS_REMOVE_COMPONENT(id, type) ECSRemoveComponent(id, typeid(type))
\ No newline at end of file
@@ -54,4 +54,12 @@ namespace ntt
      * Transform the list of components to the JSON object with the above format.
      */
     JSON ECS_ToJSON(const Dictionary<std::type_index, Ref<ComponentBase>> &components);
+
+    /**
+     * Create the deep copy of the list of components (see ComponentBase::Clone),
+     *      the components which do not support cloning are ignored
+     *      (warning will be logged).
+     */
+    Dictionary<std::type_index, Ref<ComponentBase>> ECS_Clone(
+        const Dictionary<std::type_index, Ref<ComponentBase>> &components);
 } // namespace ntt
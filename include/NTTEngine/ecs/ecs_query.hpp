@@ -0,0 +1,313 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <typeindex>
+#include <utility>
+#include <type_traits>
+#include "component_base.hpp"
+#include <NTTEngine/structures/span.hpp>
+
+/**
+ * Typed iteration over the entities which have all the given components.
+ *      The component types are resolved into small integer ids once per type
+ *      (not per call), and the matched archetypes are walked column by column,
+ *      so the components are passed as plain references without any map
+ *      lookup, casting through shared pointers or allocation.
+ *
+ * The components which are queried with the non-const types are marked as
+ *      changed for each visited entity, query the const types for the
+ *      read-only access. The Changed<T>/Added<T> filters only visit the
+ *      entities whose component is changed/added after the last update of
+ *      the running system.
+ *
+ * Usage:
+ *      ECSQuery<Geometry, const Mass>().ForEach(
+ *          [](entity_id_t id, Geometry &geo, const Mass &mass) { ... });
+ *
+ *      ECSQuery<Geometry>().Filter(Changed<Geometry>()).ForEach(...);
+ *
+ *      ECSForEach<Geometry>([](entity_id_t id, Geometry &geo) { ... });
+ *
+ *      // inside UpdateBatch, only the entities of the batch
+ *      ECSQuery<Geometry, const Mass>().ForEach(ids, ...);
+ */
+namespace ntt
+{
+    using component_type_id_t = u32;
+
+#define MAX_QUERY_COMPONENTS 16
+#define MAX_QUERY_FILTERS 4
+#define QUERY_SINCE_LAST_RUN 0xFFFFFFFF ///< Use the last update tick of the running system
+
+    /**
+     * Retrieve the id of the component type, the id is created when the type
+     *      is used for the first time and is kept for the whole program
+     *      (it's not reset with ECSInit/ECSShutdown).
+     */
+    component_type_id_t ECSGetComponentTypeId(std::type_index type);
+
+    /**
+     * The cached version of ECSGetComponentTypeId, the registry is only
+     *      touched at the first call for each type.
+     */
+    template <typename T>
+    component_type_id_t ComponentTypeId()
+    {
+        static const component_type_id_t id = ECSGetComponentTypeId(typeid(std::remove_const_t<T>));
+        return id;
+    }
+
+    /**
+     * The tick which can be passed as the `since` of the filters to only see
+     *      the changes which are made from now on. The ticks are increased
+     *      for each system update (and after ECSUpdate), so the changes made
+     *      just before the call within the same tick are seen as well.
+     */
+    u32 ECSGetChangeTick();
+
+    enum QueryFilterType
+    {
+        QUERY_FILTER_CHANGED,
+        QUERY_FILTER_ADDED,
+    };
+
+    struct QueryFilter
+    {
+        QueryFilterType type;
+        component_type_id_t componentType;
+        u32 since; ///< Only the ticks which are greater than this value pass
+    };
+
+    /**
+     * Only visit the entities whose component T is changed (or added) after
+     *      the given tick (default is the last update of the running system)
+     */
+    template <typename T>
+    QueryFilter Changed(u32 since = QUERY_SINCE_LAST_RUN)
+    {
+        return {QUERY_FILTER_CHANGED, ComponentTypeId<T>(), since};
+    }
+
+    /**
+     * Only visit the entities whose component T is added after the given
+     *      tick (default is the last update of the running system)
+     */
+    template <typename T>
+    QueryFilter Added(u32 since = QUERY_SINCE_LAST_RUN)
+    {
+        return {QUERY_FILTER_ADDED, ComponentTypeId<T>(), since};
+    }
+
+    /**
+     * The rows of an archetype which matches the query, the columns are in
+     *      the same order as the queried types. Only the first `count` rows
+     *      are visited (or the `count` listed rows), the rows which are added
+     *      while visiting (the entities which are created inside the query)
+     *      are skipped.
+     */
+    struct ArchetypeChunk
+    {
+        const List<entity_id_t> *entities;
+        const u32 *rows; ///< The visited rows, nullptr for the first `count` rows
+        u32 count;
+        const List<Ref<ComponentBase>> *const *columns;
+        List<u32> *const *changedTicks;    ///< The changed ticks of the queried columns
+        const List<u32> *const *filterTicks; ///< The ticks which are checked by each filter
+        const u32 *filterSince;            ///< The resolved `since` of each filter
+        u32 filtersCount;
+        u32 tick; ///< The tick which is written into the changed components
+    };
+
+    using ArchetypeChunkFunc = void (*)(const ArchetypeChunk &chunk, void *userData);
+
+    /**
+     * Call the function with every archetype which contains all the given
+     *      component types. The entity deletions and component state changes
+     *      which are requested while iterating are deferred until the
+     *      outermost iteration (or ECSUpdate) is finished, and the layers
+     *      which are cleared are cleared right after the outermost iteration,
+     *      so no row is removed or moved while the chunks are visited.
+     *
+     * @param types The ids of the component types (see ComponentTypeId)
+     * @param typesCount The number of types, at most MAX_QUERY_COMPONENTS
+     * @param filters The filters of the query, at most MAX_QUERY_FILTERS
+     * @param filtersCount The number of filters
+     * @param func The function which is called with each matched chunk
+     * @param userData Passed to the function as is
+     */
+    void ECSForEachChunk(const component_type_id_t *types,
+                         u32 typesCount,
+                         const QueryFilter *filters,
+                         u32 filtersCount,
+                         ArchetypeChunkFunc func,
+                         void *userData);
+
+    /**
+     * Same as ECSForEachChunk but only the given entities are visited (like
+     *      the batch of a system), the consecutive entities of the same
+     *      archetype are passed as a single chunk. The invalid (or deleted)
+     *      entities and the entities which miss any type are skipped.
+     */
+    void ECSForEachChunkOf(Span<const entity_id_t> ids,
+                           const component_type_id_t *types,
+                           u32 typesCount,
+                           const QueryFilter *filters,
+                           u32 filtersCount,
+                           ArchetypeChunkFunc func,
+                           void *userData);
+
+    template <typename... Ts>
+    class ECSQuery
+    {
+        static_assert(sizeof...(Ts) > 0, "The query needs at least one component type");
+        static_assert(sizeof...(Ts) <= MAX_QUERY_COMPONENTS, "Too many component types in the query");
+
+    public:
+        ECSQuery() : m_filtersCount(0) {}
+
+        /**
+         * Add the filter (Changed<T> or Added<T>) to the query, all the
+         *      filters must be passed for the entity to be visited.
+         */
+        ECSQuery &Filter(const QueryFilter &filter)
+        {
+            if (m_filtersCount < MAX_QUERY_FILTERS)
+            {
+                m_filters[m_filtersCount++] = filter;
+            }
+
+            return *this;
+        }
+
+        /**
+         * Call the function with each entity which has all the queried
+         *      components (all of them must be active).
+         *
+         * @param func Callable with the signature `void(entity_id_t, Ts &...)`
+         */
+        template <typename Func>
+        void ForEach(Func &&func)
+        {
+            Run<TRUE>(func);
+        }
+
+        /**
+         * Same as ForEach but only the given entities are visited in their
+         *      order, the components are resolved once per archetype instead
+         *      of once per entity
+         */
+        template <typename Func>
+        void ForEach(Span<const entity_id_t> ids, Func &&func)
+        {
+            const component_type_id_t types[] = {ComponentTypeId<Ts>()...};
+
+            ECSForEachChunkOf(
+                ids,
+                types,
+                sizeof...(Ts),
+                m_filters,
+                m_filtersCount,
+                &VisitChunk<TRUE, std::remove_reference_t<Func>>,
+                &func);
+        }
+
+        /**
+         * The number of entities which match the query, the components are
+         *      not marked as changed
+         */
+        u32 Count()
+        {
+            u32 count = 0;
+            auto counter = [&count](entity_id_t, Ts &...)
+            { count++; };
+            Run<FALSE>(counter);
+            return count;
+        }
+
+    private:
+        QueryFilter m_filters[MAX_QUERY_FILTERS];
+        u32 m_filtersCount;
+
+        template <b8 markChanged, typename Func>
+        void Run(Func &func)
+        {
+            const component_type_id_t types[] = {ComponentTypeId<Ts>()...};
+
+            ECSForEachChunk(
+                types,
+                sizeof...(Ts),
+                m_filters,
+                m_filtersCount,
+                &VisitChunk<markChanged, std::remove_reference_t<Func>>,
+                &func);
+        }
+
+        template <b8 markChanged, typename Func>
+        static void VisitChunk(const ArchetypeChunk &chunk, void *userData)
+        {
+            ForEachInChunk<markChanged>(chunk,
+                                        *static_cast<Func *>(userData),
+                                        std::index_sequence_for<Ts...>{});
+        }
+
+        template <b8 markChanged, typename Func, size_t... Is>
+        static void ForEachInChunk(const ArchetypeChunk &chunk,
+                                   Func &func,
+                                   std::index_sequence<Is...>)
+        {
+            for (u32 i = 0; i < chunk.count; i++)
+            {
+                u32 row = chunk.rows != nullptr ? chunk.rows[i] : i;
+
+                // the columns are indexed through the lists since they can be
+                //      reallocated when a new entity is created inside the query
+                if (!((*chunk.columns[Is])[row]->active && ...))
+                {
+                    continue;
+                }
+
+                if (!IsFilterPassed(chunk, row))
+                {
+                    continue;
+                }
+
+                func((*chunk.entities)[row], static_cast<Ts &>(*(*chunk.columns[Is])[row])...);
+
+                if constexpr (markChanged)
+                {
+                    (MarkChanged<Ts>(chunk, Is, row), ...);
+                }
+            }
+        }
+
+        static b8 IsFilterPassed(const ArchetypeChunk &chunk, u32 row)
+        {
+            for (u32 i = 0; i < chunk.filtersCount; i++)
+            {
+                if ((*chunk.filterTicks[i])[row] <= chunk.filterSince[i])
+                {
+                    return FALSE;
+                }
+            }
+
+            return TRUE;
+        }
+
+        template <typename T>
+        static void MarkChanged(const ArchetypeChunk &chunk, u32 column, u32 row)
+        {
+            if constexpr (!std::is_const_v<T>)
+            {
+                (*chunk.changedTicks[column])[row] = chunk.tick;
+            }
+        }
+    };
+
+    /**
+     * Shortcut of `ECSQuery<Ts...>().ForEach(func)`
+     */
+    template <typename... Ts, typename Func>
+    void ECSForEach(Func &&func)
+    {
+        ECSQuery<Ts...>().ForEach(std::forward<Func>(func));
+    }
+} // namespace ntt
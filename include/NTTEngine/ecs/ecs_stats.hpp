@@ -0,0 +1,63 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/structures/string.hpp>
+#include <NTTEngine/structures/list.hpp>
+
+/**
+ * The runtime statistics of the ECS, the counters are always collected (not
+ *      only in the profiling builds) and cost two clock reads per system
+ *      update, so they can be checked in the running game without
+ *      recompiling.
+ *
+ * Usage:
+ *      for (auto &stats : ECSGetSystemStats())
+ *      {
+ *          NTT_ENGINE_INFO("{}: {} ms", stats.name, stats.averageTime);
+ *      }
+ */
+namespace ntt
+{
+#define ECS_STATS_WINDOW 120 ///< The number of updates which the timings are kept for
+
+    struct SystemStats
+    {
+        String name;
+        b8 active;
+        u32 entitiesCount; ///< The number of entities which are processed in the last update
+        f32 lastTime;      ///< The time of the last update (milliseconds)
+        f32 totalTime;     ///< The total time of the updates in the window (milliseconds)
+        f32 averageTime;   ///< The average time of the updates in the window (milliseconds)
+        f32 maxTime;       ///< The longest update in the window (milliseconds)
+        u32 updatesCount;  ///< The number of updates in the window (at most ECS_STATS_WINDOW)
+    };
+
+    struct ECSFrameStats
+    {
+        u32 entitiesCount;             ///< The number of the living entities
+        u32 archetypesCount;           ///< The number of the created archetypes
+        u32 createdEntities;           ///< The entities which are created in the last frame
+        u32 deletedEntities;           ///< The entities which are deleted in the last frame
+        u32 componentStateChanges;     ///< The components which are turned on/off in the last frame
+        u32 componentStructureChanges; ///< The components which are added/removed in the last frame
+        u32 fixedSteps;                ///< The fixed steps which are run in the last frame
+        f32 updateTime;                ///< The time of the last ECSUpdate (milliseconds)
+    };
+
+    /**
+     * The statistics of all registered systems in the registration order, the
+     *      time of a system which is split into chunks is the sum of the time
+     *      of all chunks (the CPU time, not the wall time).
+     */
+    List<SystemStats> ECSGetSystemStats();
+
+    /**
+     * The statistics of the whole ECS in the last frame, the changes which are
+     *      made between two ECSUpdate are counted in the next frame.
+     */
+    ECSFrameStats ECSGetFrameStats();
+
+    /**
+     * Clear all the timings and counters (the systems keep running)
+     */
+    void ECSResetStats();
+} // namespace ntt
@@ -0,0 +1,63 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/structures/string.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <NTTEngine/structures/dictionary.hpp>
+#include <NTTEngine/core/parser/json.hpp>
+#include "component_base.hpp"
+#include <typeindex>
+
+/**
+ * Prefab is the named template of an entity. The components are parsed (or
+ *      given) only once and kept as the prototype, then each instance receives
+ *      the clone of the prototype components (see ComponentBase::Clone), and
+ *      all instances are created with a single ECSCreateEntities call.
+ */
+namespace ntt
+{
+    /**
+     * Register the prefab with the given components, the components are
+     *      cloned so changing them later does not affect the prefab.
+     *      If the prefab with the same name exists, then it's replaced.
+     *
+     * @param name The unique name of the prefab
+     * @param components The prototype components of the prefab
+     */
+    void ECSRegisterPrefab(const String &name,
+                           const Dictionary<std::type_index, Ref<ComponentBase>> &components);
+
+    /**
+     * Register the prefab from the JSON with the format of ECS_From (see
+     *      ecs_helper.hpp), the JSON is only parsed in this function.
+     */
+    void ECSRegisterPrefab(const String &name, const JSON &components);
+
+    /**
+     * Check whether the prefab with the given name is registered
+     */
+    b8 ECSHasPrefab(const String &name);
+
+    /**
+     * Create the entities from the prefab in the current layer, each entity has
+     *      its own copy of the prototype components and is named after
+     *      the prefab.
+     *
+     * @param name The name of the registered prefab
+     * @param count The number of entities to be created
+     *
+     * @return The IDs of the created entities, if the prefab is not found,
+     *      then an empty list is returned (warning will be logged)
+     */
+    List<entity_id_t> ECSInstantiatePrefab(const String &name, u32 count = 1);
+
+    /**
+     * Remove the prefab, the entities which are already created from the
+     *      prefab are not affected.
+     */
+    void ECSRemovePrefab(const String &name);
+
+    /**
+     * Remove all registered prefabs, it's called automatically by ECSShutdown
+     */
+    void ECSRemoveAllPrefabs();
+} // namespace ntt
@@ -0,0 +1,62 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/core/memory.hpp>
+#include <NTTEngine/core/object.hpp>
+#include <NTTEngine/structures/string.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include "component_base.hpp"
+#include "layer_types.hpp"
+#include <typeindex>
+
+/**
+ * The snapshot is the copy of all entities of some layers at a moment, the
+ *      components are cloned (see ComponentBase::Clone) and packed entity by
+ *      entity in a single list. Restoring the snapshot replaces the entities
+ *      of these layers without parsing any scene or running the scene
+ *      scripts, and the same snapshot can be restored many times (the
+ *      components are cloned again each time).
+ *
+ * Usage:
+ *      auto snapshot = ECSSnapshot({GAME_LAYER});
+ *      ... // play the game
+ *      ECSRestore(snapshot);
+ */
+namespace ntt
+{
+    struct WorldSnapshot : public Object
+    {
+        struct Entity
+        {
+            entity_id_t id;
+            String name;
+            layer_t layer;
+            u32 firstComponent;  ///< The index of the first component in `components`
+            u32 componentsCount; ///< The number of the components of the entity
+        };
+
+        List<layer_t> layers;
+        List<Entity> entities;
+        List<std::type_index> types;         ///< The type of each component
+        List<Ref<ComponentBase>> components; ///< The cloned components of all entities
+    };
+
+    /**
+     * Capture all the entities of the given layers, the entities which are
+     *      deleted in the current frame are not captured. The components
+     *      which cannot be cloned are skipped (warning will be logged).
+     */
+    Ref<WorldSnapshot> ECSSnapshot(const List<layer_t> &layers = {GAME_LAYER});
+
+    /**
+     * Delete all the entities of the snapshot layers and create the captured
+     *      entities again. The entities keep their captured IDs when the
+     *      slots are free (the others receive new IDs and the references are
+     *      updated with ComponentBase::RemapEntities).
+     *
+     * Inside ECSUpdate or a query, the old entities are only deleted at the
+     *      end of the frame, so the restored entities always receive new IDs.
+     *
+     * @return The IDs of the restored entities in the snapshot order
+     */
+    List<entity_id_t> ECSRestore(Ref<WorldSnapshot> snapshot);
+} // namespace ntt
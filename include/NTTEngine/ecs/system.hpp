@@ -2,9 +2,40 @@
 #include <NTTEngine/defines.hpp>
 #include "entity_info.hpp"
 #include "NTTEngine/core/object.hpp"
+#include <NTTEngine/structures/span.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <typeindex>
 
 namespace ntt
 {
+    /**
+     * Declaration of which components a system touches while updating, the
+     *      ECS uses it for running the systems which do not conflict with
+     *      each other at the same time on the worker threads.
+     *
+     * A system without any declared component is treated as exclusive (it
+     *      may touch anything, like the renderer, the events or the scripts),
+     *      so it is always updated alone on the main thread.
+     */
+    struct SystemAccess
+    {
+        List<std::type_index> reads;  ///< The components which are only read
+        List<std::type_index> writes; ///< The components which are modified
+        b8 splittable = FALSE;        ///< The entities can be updated in separated
+                                      ///<    chunks at the same time (each entity
+                                      ///<    only touches its own components)
+
+        SystemAccess() = default;
+        SystemAccess(List<std::type_index> reads,
+                     List<std::type_index> writes,
+                     b8 splittable = FALSE)
+            : reads(reads), writes(writes), splittable(splittable)
+        {
+        }
+
+        b8 IsDeclared() const { return !reads.empty() || !writes.empty(); }
+    };
+
     /**
      * Store all lifetime functionalitiy of a system.
      */
@@ -31,6 +62,17 @@ namespace ntt
          */
         virtual void Update(f32 delta, entity_id_t id) = 0;
 
+        /**
+         * The function which is called once per frame with all entities which
+         *      need to be updated by this system (after the layer filtering).
+         *
+         * The default implementation calls the `Update` for each entity which
+         *      still exists, the system can override this function for
+         *      processing the whole batch at once (the `Update` must still be
+         *      implemented but can be left empty).
+         */
+        virtual void UpdateBatch(f32 delta, Span<const entity_id_t> ids);
+
         /**
          * The function which is called for every entity which are registered
          *      (related to this system) in the ECS system.
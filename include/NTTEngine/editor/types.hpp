@@ -26,6 +26,7 @@ namespace ntt
 
         void RemoveAllEntities();
         void ReloadEntities();
+        void RestoreEntities(Ref<WorldSnapshot> snapshot);
         void SaveEntitiesInfo();
 
         void AddEntity();
@@ -12,7 +12,7 @@ void ConfigureStoredPath();
 String GetSourceDir();
 List<std::pair<String, SceneContext>> GetSceneFuncs();
 
-int main()
+int main(int argc, char **argv)
 {
     MemoryInit();
     LogInit();
@@ -33,6 +33,7 @@ int main()
 
     LoadConfiguration(RelativePath("assets/configs/config.json"));
     auto config = GetConfiguration();
+    auto headless = ParseHeadlessOptions(argc, argv, config);
 
     ProfilingBegin("Initialization");
 
@@ -53,7 +54,8 @@ int main()
 #else
         FALSE
 #endif
-    );
+        ,
+        headless);
 
     b8 running = true;
 
@@ -19,6 +19,8 @@ namespace ntt
 
         String GetName() const override;
 
+        Ref<ComponentBase> Clone() const override;
+
         JSON ToJSON() const override;
         void FromJSON(const JSON &data) override;
 
@@ -30,6 +30,8 @@ namespace ntt
         void AddForceConst(position_t x, position_t y);
 
         String GetName() const override;
+
+        Ref<ComponentBase> Clone() const override;
         void FromJSON(const JSON &json) override;
         JSON ToJSON() const override;
 
@@ -13,6 +13,7 @@ namespace ntt
         void InitSystem() override;
         void InitEntity(entity_id_t id) override;
         void Update(f32 delta, entity_id_t id) override;
+        void UpdateBatch(f32 delta, Span<const entity_id_t> ids) override;
         void ShutdownEntity(entity_id_t id) override;
         void ShutdownSystem() override;
 
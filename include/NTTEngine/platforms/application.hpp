@@ -19,6 +19,52 @@ namespace ntt
         std::function<void()> Close;
     };
 
+    /**
+     * The options of the headless mode, the application runs without the window
+     *      and the audio device, the renderer and the input are bound to the
+     *      fake backends, so the game logic can be simulated on the machines
+     *      without a display (servers, CI, replays).
+     */
+    struct HeadlessOptions
+    {
+        b8 enabled = FALSE;
+        f32 fixedDelta = 0.0f; ///< The delta of each frame (milliseconds), 0 for the real elapsed time
+        u32 maxFrames = 0;     ///< The application stops after this number of frames, 0 for no limit
+    };
+
+    /**
+     * Read the headless options from the configuration ("headless", "fixedDelta",
+     *      "maxFrames") and then from the command line arguments which
+     *      override the configuration:
+     *      --headless, --fixed-delta=<milliseconds>, --frames=<count>
+     *
+     * @param argc: the number of the command line arguments
+     * @param argv: the command line arguments (the first one is the program)
+     * @param config: the configuration of the application
+     */
+    HeadlessOptions ParseHeadlessOptions(i32 argc,
+                                         char **argv,
+                                         const JSON &config = JSON("{}"));
+
+    /**
+     * Run one frame without the window, the drawing commands are recorded by
+     *      the fake graphic API, and the loop runs as fast as possible (no
+     *      target FPS). Every entry point which runs the headless mode uses
+     *      it, so the simulated frames are the same everywhere.
+     *
+     * @param options: the headless options, the frame delta is replaced by
+     *      the fixed delta if it's set
+     * @param frames: the number of the simulated frames, increased by one
+     * @param elapsed: the real elapsed time of the frame (milliseconds)
+     * @param mainLoop: the update of the user which runs before the ECS
+     *
+     * @return FALSE if the maximum number of frames is reached
+     */
+    b8 HeadlessStep(const HeadlessOptions &options,
+                    u32 &frames,
+                    f32 elapsed,
+                    const std::function<void(f32)> &mainLoop = nullptr);
+
     /**
      * Making an window of application with certain width, height and title
      *
@@ -26,13 +72,28 @@ namespace ntt
      * @param screenHeight: the height of the window
      * @param title: the title of the window
      * @param phrases: the phrases of the application which is defined by the user
+     * @param headless: if enabled, no window is created and the editor is
+     *      disabled, the loop is stopped after the maximum number of frames
      */
     void ApplicationInit(u16 screenWidth,
                          u16 screenHeight,
                          const char *title,
                          const Phrases &phrases,
                          List<String> sceneNames,
-                         b8 editor = FALSE);
+                         b8 editor = FALSE,
+                         const HeadlessOptions &headless = {});
+
+    /**
+     * Register the built-in systems of the engine with the components they
+     *      read and write, the application and the game/editor executables
+     *      share it so the systems, their order and their access are the same
+     *      everywhere. Must be called after ECSInit (and ThreadPoolInit for
+     *      the parallel systems).
+     *
+     * @param editor: the render system draws for the editor and the editor
+     *      system is registered
+     */
+    void RegisterEngineSystems(b8 editor = FALSE);
 
     /**
      * Storing the JSON configuration data for the
@@ -57,6 +118,11 @@ namespace ntt
      */
     void ApplicationUpdate(b8 &running);
 
+    /**
+     * Check whether the application is running in the headless mode
+     */
+    b8 IsHeadless();
+
     /**
      * Get the current size of the window
      *
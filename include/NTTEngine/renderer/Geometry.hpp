@@ -25,6 +25,12 @@ namespace ntt
         // should not be used by user, only used by the renderer and editor
         Size originalSize;
 
+        // the state before the last fixed step which moved the entity (kept
+        //      by the ECS, see ECSSetFixedStep)
+        Position lastPos;
+        f32 lastRotation = 0.0f;
+        u32 lastStep = 0;
+
         Geometry(position_t x = POSITION_DEFAULT, position_t y = POSITION_DEFAULT,
                  ntt_size_t width = SIZE_DEFAULT, ntt_size_t height = SIZE_DEFAULT,
                  f32 rotation = 0.0f, u8 priority = PRIORITY_0,
@@ -36,10 +42,20 @@ namespace ntt
         {
         }
 
+        /**
+         * The position/rotation which should be drawn, if the entity is
+         *      updated by the fixed systems, then the state is interpolated
+         *      between the last two fixed steps, otherwise the current state
+         */
+        Position GetDrawnPos() const;
+        f32 GetDrawnRotation() const;
+
         virtual void TurnOff() override;
         virtual void TurnOn() override;
 
         String GetName() const override;
+
+        Ref<ComponentBase> Clone() const override;
         JSON ToJSON() const override;
         void FromJSON(const JSON &json) override;
         void OnEditorUpdate(std::function<void()> onChanged = nullptr, void *data = nullptr) override;
@@ -1,6 +1,7 @@
 #pragma once
 #include <NTTEngine/defines.hpp>
 #include <NTTEngine/structures/string.hpp>
+#include <NTTEngine/structures/list.hpp>
 #include <NTTEngine/structures/position.hpp>
 #include <NTTEngine/structures/size.hpp>
 #include <NTTEngine/resources/resource_common.h>
@@ -44,8 +45,42 @@ namespace ntt
      * @param grid: (Optional) The grid of the texture which are how many
      *      rows and columns in the texture, if the grid is not provided
      *      then the default grid will be used (only 1 row and 1 column).
+     *
+     * @param async: (Optional) Decode the image on the thread pool, the size
+     *      is read from the file header so the texture ID can be used right
+     *      away, a placeholder is drawn until the image is uploaded (in
+     *      GraphicUpdate, a few images per frame). Only the PNG headers are
+     *      read, the other formats are loaded synchronously.
+     */
+    resource_id_t LoadTexture(const String &path,
+                              const Grid &grid = Grid{1, 1},
+                              b8 async = FALSE);
+
+    /**
+     * Pack the images into the atlas pages (a page is a single texture with
+     *      multiple images), the next LoadTexture of these paths uses the
+     *      region of the image in the page, so the sprites of different
+     *      images can be drawn in the same batch. The page is unloaded when
+     *      all of its textures are unloaded.
+     *
+     * The images which are already loaded, not found or too large for a page
+     *      are ignored (they are loaded as separate textures).
+     *
+     * @param paths: The paths of the images which are loaded together (the
+     *      images of a scene or a project)
+     * @param async: (Optional) Decode the images on the thread pool, the page
+     *      is uploaded when all of its images are decoded (see LoadTexture)
      */
-    resource_id_t LoadTexture(const String &path, const Grid &grid = Grid{1, 1});
+    void LoadTextureAtlas(const List<String> &paths, b8 async = FALSE);
+
+    /**
+     * The number of the loaded textures which are still decoding or waiting
+     *      for the upload (drawn as the placeholders), used by the loading
+     *      screens. The texture which cannot be decoded is loaded again
+     *      synchronously, if that also fails, then it's not drawn and not
+     *      counted anymore.
+     */
+    u32 GetLoadingTexturesCount();
 
     /**
      * The context which the renderer used for drawing
@@ -226,12 +261,37 @@ namespace ntt
      */
     const List<entity_id_t> &GetHoveredTexture();
 
+    /**
+     * The counters of the last GraphicUpdate (summed over all cameras)
+     */
+    struct RendererStats
+    {
+        u32 drawCommands;    ///< The commands which are submitted in the frame
+        u32 drawCalls;       ///< The calls to the graphic API (a texture batch is one call)
+        u32 textureBatches;  ///< The batches of the sprites which share a texture
+        u32 textureSwitches; ///< The times the texture is changed between two batches
+        u32 culledCommands;  ///< The commands which are outside of the camera views (not drawn)
+    };
+
+    /**
+     * Retrieve the counters of the last GraphicUpdate, used for checking how
+     *      well the sprites are batched.
+     */
+    RendererStats GetRendererStats();
+
     /**
      * Registering the camera which will affect the rendering output into multiple
      *      cameras' frames.
      */
     camera_id_t AddCamera(Position outputFramePos, Size outputFrameSize);
 
+    /**
+     * Check whether the rectangle (centered at the position, in the world
+     *      space) overlaps the view of at least one camera, used for skipping
+     *      the submission of the objects which are not displayed.
+     */
+    b8 IsInCameraView(const Position &position, const Size &size, f32 rotate = 0.0f);
+
     /**
      * Camera information which is used for the rendering
      */
@@ -253,6 +313,15 @@ namespace ntt
      * This function also tracking the hovered entity (provided via id)
      *      and display the tooltip if the mouse is hovered on the object.
      *
+     * Each camera only draws the commands in its view (the commands are
+     *      indexed by a uniform grid), and only the commands under the mouse
+     *      are checked for the hovering.
+     *
+     * The commands of the same priority are drawn in the submission order,
+     *      except the textures between two other commands which are sorted
+     *      by their texture, the consecutive textures with the same texture
+     *      are drawn as a single batch.
+     *
      * In debugging mode, if the user hovers on an entity which is not the
      *      EDITOR_LAYER, then the entity will be highlighted and the user
      *      can click to trigger the event NTT_DEBUG_CHOOSE_ENTITY.
@@ -6,8 +6,12 @@
 namespace ntt
 {
     /**
-     * Store the information about the segment of the texture
-     *      which is needed to draw on the screen.
+     * The local transform of the entity relative to its parent, the
+     *      Geometry of the entity is the world transform which is resolved
+     *      by the ParentSystem (the parent can have its own parent).
+     *
+     * `angle` is the rotation (in degrees) which is added to the rotation
+     *      of the parent.
      */
     struct Parent : public ComponentBase
     {
@@ -27,5 +31,18 @@ namespace ntt
         {
             return "Parent";
         }
+
+        Ref<ComponentBase> Clone() const override
+        {
+            return CreatePooledRef<Parent>(*this);
+        }
+
+        void RemapEntities(const Dictionary<entity_id_t, entity_id_t> &ids) override
+        {
+            if (ids.Contains(parentId))
+            {
+                parentId = ids.at(parentId);
+            }
+        }
     };
 } // namespace ntt
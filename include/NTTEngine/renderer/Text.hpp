@@ -29,5 +29,10 @@ namespace ntt
         {
             return "Text";
         }
+
+        Ref<ComponentBase> Clone() const override
+        {
+            return CreatePooledRef<Text>(*this);
+        }
     };
 } // namespace ntt
@@ -58,6 +58,11 @@ namespace ntt
      * If a resource is already loadded (name of it exists) the that
      *      resource will be ignored.
      *
+     * The images of the list are packed into the texture atlases (see
+     *      LoadTextureAtlas), an image which sets "atlas": false in its
+     *      additional information is loaded as a separate texture. The
+     *      images are decoded in the background unless "async": false is set.
+     *
      * @param infos The list of resource information.
      */
     void ResourceLoad(List<ResourceInfo> infos);
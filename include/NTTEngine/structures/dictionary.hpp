@@ -18,9 +18,9 @@ namespace ntt
         Dictionary(std::initializer_list<std::pair<const K, V>> list) : std::map<K, V>(list) {}
         Dictionary(const Dictionary<K, V> &dict) : std::map<K, V>(dict) {}
 
-        inline bool Contains(K key) { return this->find(key) != this->end(); }
+        inline bool Contains(K key) const { return this->find(key) != this->end(); }
 
-        List<K> Keys()
+        List<K> Keys() const
         {
             List<K> keys;
             for (auto &pair : (*this))
@@ -30,7 +30,7 @@ namespace ntt
             return keys;
         }
 
-        List<V> Values()
+        List<V> Values() const
         {
             List<V> values;
             for (auto &pair : (*this))
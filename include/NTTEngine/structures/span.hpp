@@ -0,0 +1,52 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include "list.hpp"
+
+namespace ntt
+{
+    /**
+     * Non-owning view over a contiguous range of items (a part of a List or
+     *      a raw array). The span is only valid while the viewed memory is
+     *      not resized or released.
+     */
+    template <typename T>
+    class Span
+    {
+    public:
+        Span() : m_data(nullptr), m_size(0) {}
+        Span(T *data, u32 size) : m_data(data), m_size(size) {}
+
+        template <typename U>
+        Span(const List<U> &list) : m_data(list.data()), m_size(list.size()) {}
+
+        template <typename U>
+        Span(List<U> &list) : m_data(list.data()), m_size(list.size()) {}
+
+        u32 size() const { return m_size; }
+        b8 empty() const { return m_size == 0; }
+        T *data() const { return m_data; }
+
+        T &operator[](u32 index) const { return m_data[index]; }
+
+        T *begin() const { return m_data; }
+        T *end() const { return m_data + m_size; }
+
+        /**
+         * Create the view of the items in range [start, start + count), the
+         *      range is clamped to the size of the current span
+         */
+        Span<T> SubSpan(u32 start, u32 count) const
+        {
+            if (start >= m_size)
+            {
+                return Span<T>();
+            }
+
+            return Span<T>(m_data + start, count < m_size - start ? count : m_size - start);
+        }
+
+    private:
+        T *m_data;
+        u32 m_size;
+    };
+} // namespace ntt
@@ -0,0 +1,132 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include "list.hpp"
+
+namespace ntt
+{
+    /**
+     * The default mapping of the SparseSet, the item itself is the index
+     */
+    struct IdentityIndexOf
+    {
+        template <typename T>
+        static u32 Get(T item) { return static_cast<u32>(item); }
+    };
+
+    /**
+     * Set of unsigned integer ids (entity ids, system ids, ...) which supports
+     *      O(1) adding, removing and membership checking. The items are stored
+     *      densely so iterating over the set is a linear walk.
+     *
+     * The sparse array grows up to the largest added id, so this structure
+     *      should only be used with small, densely allocated ids.
+     *
+     * Removing an item moves the last item into its place, so the iteration
+     *      order is not the adding order after any removal.
+     *
+     * @tparam IndexOf Provides the static `u32 Get(T)` which maps the item into
+     *      its sparse index, at most one item of the same index can be in the
+     *      set (adding an item replaces the other item with the same index).
+     */
+    template <typename T, typename IndexOf = IdentityIndexOf>
+    class SparseSet
+    {
+    public:
+        SparseSet() : m_dense(), m_sparse() {}
+        SparseSet(std::initializer_list<T> list) : m_dense(), m_sparse()
+        {
+            for (auto item : list)
+            {
+                Add(item);
+            }
+        }
+
+        /**
+         * Add the item to the set, if the item is already added then
+         *      nothing will be changed
+         */
+        void Add(T item)
+        {
+            if (Contains(item))
+            {
+                return;
+            }
+
+            u32 index = IndexOf::Get(item);
+
+            if (index >= m_sparse.size())
+            {
+                m_sparse.resize(index + 1, INVALID_INDEX);
+            }
+
+            if (m_sparse[index] != INVALID_INDEX)
+            {
+                RemoveItem(m_dense[m_sparse[index]]);
+            }
+
+            m_sparse[index] = m_dense.size();
+            m_dense.push_back(item);
+        }
+
+        /**
+         * Remove the item from the set by moving the last item into its place,
+         *      if the item is not in the set then nothing will be changed
+         */
+        void RemoveItem(T item)
+        {
+            if (!Contains(item))
+            {
+                return;
+            }
+
+            u32 index = m_sparse[IndexOf::Get(item)];
+            T last = m_dense.back();
+
+            m_dense[index] = last;
+            m_sparse[IndexOf::Get(last)] = index;
+
+            m_dense.pop_back();
+            m_sparse[IndexOf::Get(item)] = INVALID_INDEX;
+        }
+
+        b8 Contains(T item) const
+        {
+            u32 index = IndexOf::Get(item);
+            return index < m_sparse.size() &&
+                   m_sparse[index] != INVALID_INDEX &&
+                   m_dense[m_sparse[index]] == item;
+        }
+
+        /**
+         * Remove all items, the allocated memory is kept for the next usage
+         */
+        void clear()
+        {
+            for (auto item : m_dense)
+            {
+                m_sparse[IndexOf::Get(item)] = INVALID_INDEX;
+            }
+
+            m_dense.clear();
+        }
+
+        u32 size() const { return m_dense.size(); }
+        b8 empty() const { return m_dense.empty(); }
+
+        T operator[](u32 index) const { return m_dense[index]; }
+
+        typename List<T>::const_iterator begin() const { return m_dense.begin(); }
+        typename List<T>::const_iterator end() const { return m_dense.end(); }
+
+        /**
+         * All items of the set in the iteration order
+         */
+        const List<T> &Values() const { return m_dense; }
+
+    private:
+        static constexpr u32 INVALID_INDEX = static_cast<u32>(-1);
+
+        List<T> m_dense;
+        List<u32> m_sparse;
+    };
+} // namespace ntt
@@ -0,0 +1,26 @@
+#include <NTTEngine/dev/benchmark.hpp>
+
+#include <NTTEngine/application/event_system/event_system.hpp>
+
+using namespace ntt;
+
+NTT_BENCHMARK(TriggerEvent, 1, 10, 100)
+{
+    EventInit();
+
+    u32 calls = 0;
+
+    for (u32 i = 0; i < bench.Argument(); i++)
+    {
+        RegisterEvent(
+            NTT_EVENT_TEST,
+            [&calls](auto code, void *sender, const EventContext &context)
+            { calls++; });
+    }
+
+    bench.SetItemsCount(bench.Argument());
+    bench.Run([]()
+              { TriggerEvent(NTT_EVENT_TEST); });
+
+    EventShutdown();
+}
@@ -28,6 +28,12 @@ namespace ntt
         return GET_SCRIPT(Script, objId);
     }
 
+    Ref<ComponentBase> NativeScriptComponent::Clone() const
+    {
+        // the script object is created per entity by the script system
+        return CreatePooledRef<NativeScriptComponent>(scriptName, INVALID_OBJECT_ID, data);
+    }
+
     String NativeScriptComponent::GetName() const
     {
         PROFILE_FUNCTION();
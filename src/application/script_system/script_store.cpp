@@ -5,6 +5,7 @@
 #include <NTTEngine/core/formatter.hpp>
 #include <functional>
 #include <NTTEngine/core/object.hpp>
+#include <NTTEngine/core/pool_allocator.hpp>
 #include <NTTEngine/core/profiling.hpp>
 #include <NTTEngine/application/script_system/state.hpp>
 #include "defs.hpp"
@@ -34,7 +35,7 @@ namespace ntt
         };
 
         Scope<Store<resource_id_t, ScriptData>> s_scripts;
-        Scope<Store<script_object_id_t, ScriptObjectData>> s_objects;
+        Scope<Store<script_object_id_t, ScriptObjectData, resource_id_t>> s_objects;
         String s_createFunc = EMPTY_FUNC_NAME;
         String s_deleteFunc = EMPTY_FUNC_NAME;
         String s_getBaseTypeFunc = EMPTY_FUNC_NAME;
@@ -42,20 +43,22 @@ namespace ntt
         GetFieldFunc<ScriptData, String> s_GetPath = [](Ref<ScriptData> obj) -> String
         { return obj->path; };
 
-        GetFieldFunc<ScriptData, String> s_GetKey = [](Ref<ScriptData> obj) -> String
-        { return obj->key; };
     } // namespace
 
     void ScriptStoreInit(const char *createFunc, const char *deleteFunc, const char *getBaseTypeFunc)
     {
         PROFILE_FUNCTION();
 
+        // the scripts are indexed by their keys, and the objects by their scripts
         s_scripts = CreateScope<Store<resource_id_t, ScriptData>>(
             0, 1000, [](Ref<ScriptData> a, Ref<ScriptData> b)
-            { return a->path == b->path; });
-        s_objects = CreateScope<Store<script_object_id_t, ScriptObjectData>>(
-            0, 1000, [](Ref<ScriptObjectData> a, Ref<ScriptObjectData> b)
-            { return FALSE; });
+            { return a->path == b->path; },
+            [](Ref<ScriptData> obj) -> String
+            { return obj->key; });
+        s_objects = CreateScope<Store<script_object_id_t, ScriptObjectData, resource_id_t>>(
+            0, 1000, nullptr,
+            [](Ref<ScriptObjectData> obj) -> resource_id_t
+            { return obj->scriptId; });
 
         s_createFunc = createFunc;
         s_deleteFunc = deleteFunc;
@@ -120,11 +123,11 @@ namespace ntt
     {
         PROFILE_FUNCTION();
 
-        auto id = s_scripts->GetIdsByField(String(key), s_GetPath);
+        auto &ids = s_scripts->GetIdsByKey(key);
 
-        if (id.size() > 0)
+        if (ids.size() > 0)
         {
-            return id[0];
+            return ids[0];
         }
 
         Ref<ScriptData> data = CreateRef<ScriptData>();
@@ -141,8 +144,7 @@ namespace ntt
     {
         PROFILE_FUNCTION();
 
-        auto ids = s_scripts->GetIdsByField(
-            key, s_GetKey);
+        auto &ids = s_scripts->GetIdsByKey(key);
 
         if (ids.size() == 1)
         {
@@ -169,10 +171,7 @@ namespace ntt
     void ScriptStoreReload(resource_id_t id, std::function<void()> callback)
     {
         auto script = s_scripts->Get(id);
-        List<script_object_id_t> objIds = s_objects->GetIdsByField<resource_id_t>(
-            id,
-            [](Ref<ScriptObjectData> obj)
-            { return obj->scriptId; });
+        List<script_object_id_t> objIds = s_objects->GetIdsByKey(id);
 
         for (auto objId : objIds)
         {
@@ -209,12 +208,8 @@ namespace ntt
 
         auto script = s_scripts->Get(id);
 
-        std::function<resource_id_t(Ref<ScriptObjectData>)> func = [id](Ref<ScriptObjectData> obj)
-        {
-            return obj->scriptId;
-        };
-
-        auto objIds = s_objects->GetIdsByField(id, func);
+        // copied since the objects are removed from the index while deleting
+        List<script_object_id_t> objIds = s_objects->GetIdsByKey(id);
 
         for (auto objId : objIds)
         {
@@ -244,7 +239,7 @@ namespace ntt
             return INVALID_OBJECT_ID;
         }
 
-        auto objData = CreateRef<ScriptObjectData>();
+        auto objData = CreatePooledRef<ScriptObjectData>();
         if (script->createFunc == nullptr || script->deleteFunc == nullptr)
         {
             return INVALID_OBJECT_ID;
@@ -312,7 +307,7 @@ namespace ntt
             ScriptStoreUnload(id);
         }
 
-        ASSERT_M(s_objects->GetAvailableIds().size() == 0, "The object store is not empty");
+        ASSERT_M(s_objects->Count() == 0, "The object store is not empty");
 
         s_objects.reset();
         s_scripts.reset();
@@ -4,6 +4,12 @@
 
 namespace ntt
 {
+    Ref<ComponentBase> StateComponent::Clone() const
+    {
+        // the state objects are created per entity by the state system
+        return CreatePooledRef<StateComponent>(stateScriptNames, defaultState);
+    }
+
     String StateComponent::GetName() const
     {
         return "StateComponent";
@@ -52,17 +52,29 @@ namespace ntt
         Store<resource_id_t, AudioInfo> s_audioStore(
             RESOURCE_ID_DEFAULT,
             MAX_AUDIO, [](Ref<AudioInfo> audio, Ref<AudioInfo> other) -> b8
-            { return audio->path == other->path; });
+            { return audio->path == other->path; },
+            [](Ref<AudioInfo> audio) -> String
+            { return audio->path; });
 
         List<PlayingAudioInfo> s_playingAudios;
+
+        /**
+         * No audio device is opened, the audios are only tracked by their
+         *      paths and are finished right after being played
+         */
+        b8 s_test = FALSE;
     } // namespace
 
-    void AudioInit()
+    void AudioInit(b8 test)
     {
         PROFILE_FUNCTION();
         s_playingAudios = {};
+        s_test = test;
 
-        INIT_DEVICE();
+        if (!s_test)
+        {
+            INIT_DEVICE();
+        }
     }
 
     void SetVolume(resource_id_t audio_id, f32 volume)
@@ -80,24 +92,27 @@ namespace ntt
             return;
         }
 
-        SET_VOLUME(audioInfo->sound, volume);
+        if (!s_test)
+        {
+            SET_VOLUME(audioInfo->sound, volume);
+        }
     }
 
     resource_id_t LoadAudio(const String &path)
     {
         PROFILE_FUNCTION();
 
-        auto existedAudioPaths = s_audioStore.GetByField<String>(
-            path,
-            [](Ref<AudioInfo> audio) -> String
-            { return audio->path; });
-
-        if (existedAudioPaths.size() > 0)
+        if (s_audioStore.GetIdsByKey(path).size() > 0)
         {
             NTT_ENGINE_WARN("The audio file is already loaded: {}", GetFileName(path, true));
             return RESOURCE_ID_DEFAULT;
         }
 
+        if (s_test)
+        {
+            return s_audioStore.Add(CreateRef<AudioInfo>(SOUND{}, path));
+        }
+
         LOAD_SOUND(sound, path);
 
         if (IS_LOADED_SUCCESS(sound))
@@ -131,7 +146,11 @@ namespace ntt
 
         s_playingAudios.RemoveItem({audio_id, context});
         s_playingAudios.push_back({audio_id, context});
-        PLAY_SOUND(audioInfo->sound);
+
+        if (!s_test)
+        {
+            PLAY_SOUND(audioInfo->sound);
+        }
     }
 
     void StopAudio(resource_id_t audio_id)
@@ -146,7 +165,7 @@ namespace ntt
             return;
         }
 
-        if (IS_SOUND_PLAYING(audioInfo->sound))
+        if (!s_test && IS_SOUND_PLAYING(audioInfo->sound))
         {
             STOP_SOUND(audioInfo->sound);
         }
@@ -170,14 +189,14 @@ namespace ntt
                 continue;
             }
 
-            if (!IS_SOUND_PLAYING(audioInfo->sound))
+            if (s_test || !IS_SOUND_PLAYING(audioInfo->sound))
             {
                 playingAudioInfo.playedTimes++;
 
                 if (playingAudioInfo.playedTimes < playingAudioInfo.context.desiredPlayedTimes ||
                     playingAudioInfo.context.desiredPlayedTimes == 0)
                 {
-                    if (s_playingAudios.Contains(playingAudioInfo))
+                    if (!s_test && s_playingAudios.Contains(playingAudioInfo))
                     {
                         PLAY_SOUND(audioInfo->sound);
                     }
@@ -210,7 +229,10 @@ namespace ntt
         }
 
         StopAudio(audio_id);
-        UNLOAD_SOUND(audioInfo->sound);
+        if (!s_test)
+        {
+            UNLOAD_SOUND(audioInfo->sound);
+        }
         s_audioStore.Release(audio_id);
     }
 
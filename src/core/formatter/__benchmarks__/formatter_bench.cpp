@@ -0,0 +1,17 @@
+#include <NTTEngine/dev/benchmark.hpp>
+
+#include <NTTEngine/core/formatter.hpp>
+
+using namespace ntt;
+
+NTT_BENCHMARK(Format)
+{
+    String name = "entity";
+    u32 index = 0;
+
+    bench.Run(
+        [&]()
+        {
+            String result = format("The {} {} is at ({}, {})", name, index++, 1.5f, -2.25f);
+        });
+}
@@ -6,6 +6,7 @@
 #include <cstdarg>
 #include <any>
 #include <vector>
+#include <mutex>
 
 namespace ntt
 {
@@ -23,6 +24,12 @@ namespace ntt
         Scope<Logger> s_appLogger = nullptr;
 
         b8 s_isInitialized = FALSE;
+
+        /**
+         * The systems can be updated on the worker threads, so the handlers
+         *      must not be called at the same time
+         */
+        std::recursive_mutex s_logMutex;
     } // namespace
 
     void LogInit()
@@ -64,10 +71,7 @@ namespace ntt
             return;
         }
 
-        if (!s_isInitialized)
-        {
-            return;
-        }
+        std::lock_guard<std::recursive_mutex> lock(s_logMutex);
 
         if (strcmp(name, ENGINE_LOGGER_NAME) == 0)
         {
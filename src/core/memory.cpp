@@ -5,12 +5,28 @@
 #include <NTTEngine/core/assertion.hpp>
 #include <NTTEngine/platforms/stream.hpp>
 #include <NTTEngine/structures/string.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <mutex>
 
 namespace ntt
 {
     namespace
     {
-        u32 s_createdObjects = 0;
+        std::atomic<i32> s_createdObjects(0);
+
+        // both are never destroyed, the counters can be registered before
+        //      (and touched after) the static objects of this file
+        std::mutex &TypesMutex()
+        {
+            static std::mutex *mutex = new std::mutex();
+            return *mutex;
+        }
+
+        List<MemoryTypeCounter *> &TypeCounters()
+        {
+            static List<MemoryTypeCounter *> *counters = new List<MemoryTypeCounter *>();
+            return *counters;
+        }
     }
 
     void MemoryInit()
@@ -22,6 +38,26 @@ namespace ntt
     void MemoryShutdown()
     {
         PROFILE_FUNCTION();
+
+#ifdef NTT_MEMORY_TRACKING
+        {
+            std::lock_guard<std::mutex> lock(TypesMutex());
+
+            for (auto counter : TypeCounters())
+            {
+                i32 liveCount = counter->liveCount.load();
+
+                if (liveCount != 0)
+                {
+                    printf("%s",
+                           format("    {} live objects of {}\n", liveCount, String(counter->name))
+                               .RawString()
+                               .c_str());
+                }
+            }
+        }
+#endif
+
         ASSERT_STA(s_createdObjects == 0,
                    printf(
                        format(
@@ -77,4 +113,21 @@ namespace ntt
     {
         s_createdObjects--;
     }
+
+    i32 MemoryGetLiveObjectsCount()
+    {
+        return s_createdObjects.load();
+    }
+
+    MemoryTypeCounter *MemoryRegisterType(const char *name)
+    {
+        auto counter = new MemoryTypeCounter();
+        counter->name = name;
+        counter->liveCount = 0;
+
+        std::lock_guard<std::mutex> lock(TypesMutex());
+        TypeCounters().push_back(counter);
+
+        return counter;
+    }
 } // namespace ntt
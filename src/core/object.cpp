@@ -1,18 +1,16 @@
 #include <NTTEngine/core/object.hpp>
-#include <iostream>
 
 namespace ntt
 {
-#define THIS(exp) this->m_impl->exp
-
-    class Object::Impl
+#ifdef NTT_MEMORY_TRACKING
+    Object::Object()
     {
-    public:
-    };
+        CREATE_NEW();
+    }
 
-    Object::Object()
+    Object::Object(const Object &other)
     {
-        this->m_impl = CreateScope<Object::Impl>();
+        // the copied object is a new object which is tracked separately
         CREATE_NEW();
     }
 
@@ -20,4 +18,5 @@ namespace ntt
     {
         DELETE_OBJ();
     }
-} // namespace ntt
\ No newline at end of file
+#endif
+} // namespace ntt
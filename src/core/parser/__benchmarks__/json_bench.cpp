@@ -0,0 +1,41 @@
+#include <NTTEngine/dev/benchmark.hpp>
+
+#include <NTTEngine/core/parser/json.hpp>
+#include <NTTEngine/ecs/entity_info.hpp>
+#include <NTTEngine/renderer/Geometry.hpp>
+#include <NTTEngine/physics/Mass.hpp>
+
+using namespace ntt;
+
+NTT_BENCHMARK(ParseScene, 100, 1000)
+{
+    List<JSON> entitiesCfg;
+
+    for (u32 i = 0; i < bench.Argument(); i++)
+    {
+        EntityInfo entity;
+        entity.name = format("entity_{}", i);
+        entity.components[typeid(Geometry)] = CreateRef<Geometry>(
+            static_cast<f32>(i), static_cast<f32>(i), 10.0f, 10.0f);
+        entity.components[typeid(Mass)] = CreateRef<Mass>(2.0f);
+        entitiesCfg.push_back(entity.ToJSON());
+    }
+
+    JSON sceneCfg("{}");
+    sceneCfg.Set<String>("sceneName", "bench");
+    sceneCfg.Set<JSON>("entities", JSON::FromList(entitiesCfg));
+    String data = sceneCfg.ToString();
+
+    bench.SetItemsCount(bench.Argument());
+    bench.Run(
+        [&]()
+        {
+            JSON scene(data);
+
+            for (auto &entityCfg : scene.GetList<JSON>("entities"))
+            {
+                EntityInfo entity;
+                entity.FromJSON(entityCfg);
+            }
+        });
+}
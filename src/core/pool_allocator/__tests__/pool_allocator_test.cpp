@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <NTTEngine/core/pool_allocator.hpp>
+#include <cstdint>
+
+using namespace ntt;
+
+namespace
+{
+    struct PooledData
+    {
+        u32 value;
+        f32 other;
+
+        PooledData(u32 value = 0, f32 other = 0.0f) : value(value), other(other) {}
+    };
+
+    struct alignas(32) AlignedData
+    {
+        u8 bytes[40];
+    };
+} // namespace
+
+TEST(MemoryPoolTest, FreedBlocksAreReused)
+{
+    MemoryPool pool(sizeof(PooledData), alignof(PooledData), 4);
+
+    void *first = pool.Allocate();
+    void *second = pool.Allocate();
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(pool.GetAllocatedCount(), 2);
+    EXPECT_EQ(pool.GetCapacity(), 4);
+
+    pool.Free(first);
+    EXPECT_EQ(pool.GetAllocatedCount(), 1);
+    EXPECT_EQ(pool.Allocate(), first);
+
+    // a new slab is only allocated when all blocks are used
+    for (u32 i = 0; i < 3; i++)
+    {
+        pool.Allocate();
+    }
+
+    EXPECT_EQ(pool.GetAllocatedCount(), 5);
+    EXPECT_EQ(pool.GetCapacity(), 8);
+}
+
+TEST(MemoryPoolTest, BlocksAreAligned)
+{
+    MemoryPool pool(sizeof(AlignedData), alignof(AlignedData), 3);
+
+    for (u32 i = 0; i < 10; i++)
+    {
+        auto block = pool.Allocate();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % alignof(AlignedData), 0);
+    }
+}
+
+TEST(MemoryPoolTest, PooledRefIsReleasedIntoThePool)
+{
+    {
+        auto data = CreatePooledRef<PooledData>(10, 2.0f);
+        EXPECT_EQ(data->value, 10);
+        EXPECT_EQ(data->other, 2.0f);
+
+        auto copied = data;
+        EXPECT_EQ(copied.use_count(), 2);
+    }
+
+    List<Ref<PooledData>> refs;
+
+    for (u32 i = 0; i < 1000; i++)
+    {
+        refs.push_back(CreatePooledRef<PooledData>(i));
+    }
+
+    for (u32 i = 0; i < refs.size(); i++)
+    {
+        EXPECT_EQ(refs[i]->value, i);
+    }
+
+    refs.clear();
+
+    // all blocks are back in the pool, and the next objects reuse them
+    for (u32 i = 0; i < 1000; i++)
+    {
+        refs.push_back(CreatePooledRef<PooledData>(i));
+    }
+
+    EXPECT_EQ(refs.size(), 1000);
+    EXPECT_EQ(refs.back()->value, 999);
+}
+
+TEST(MemoryPoolTest, LiveObjectsAreCountedPerType)
+{
+    i32 before = MemoryGetLiveCount<PooledData>();
+
+    {
+        auto pooled = CreatePooledRef<PooledData>(1);
+        auto referenced = CreateRef<PooledData>(2);
+
+#ifdef NTT_MEMORY_TRACKING
+        EXPECT_EQ(MemoryGetLiveCount<PooledData>(), before + 2);
+#else
+        EXPECT_EQ(MemoryGetLiveCount<PooledData>(), 0);
+#endif
+    }
+
+    EXPECT_EQ(MemoryGetLiveCount<PooledData>(), before);
+}
@@ -0,0 +1,88 @@
+#include <NTTEngine/core/pool_allocator.hpp>
+#include <NTTEngine/core/profiling.hpp>
+#include <new>
+
+namespace ntt
+{
+    MemoryPool::MemoryPool(u32 blockSize, u32 blockAlign, u32 blocksPerSlab)
+        : m_blockSize(0),
+          m_blockAlign(blockAlign < alignof(FreeBlock) ? alignof(FreeBlock) : blockAlign),
+          m_blocksPerSlab(blocksPerSlab == 0 ? 1 : blocksPerSlab),
+          m_allocatedCount(0),
+          m_freeList(nullptr),
+          m_slabs()
+    {
+        // the free blocks store the link to the next free block in place
+        u32 size = blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize;
+        m_blockSize = (size + m_blockAlign - 1) / m_blockAlign * m_blockAlign;
+    }
+
+    MemoryPool::~MemoryPool()
+    {
+        for (auto slab : m_slabs)
+        {
+            ::operator delete(slab, std::align_val_t(m_blockAlign));
+        }
+    }
+
+    void *MemoryPool::Allocate()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_freeList == nullptr)
+        {
+            AllocateSlab();
+        }
+
+        FreeBlock *block = m_freeList;
+        m_freeList = block->next;
+        m_allocatedCount++;
+
+        return block;
+    }
+
+    void MemoryPool::Free(void *block)
+    {
+        if (block == nullptr)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        FreeBlock *freeBlock = static_cast<FreeBlock *>(block);
+        freeBlock->next = m_freeList;
+        m_freeList = freeBlock;
+        m_allocatedCount--;
+    }
+
+    u32 MemoryPool::GetAllocatedCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_allocatedCount;
+    }
+
+    u32 MemoryPool::GetCapacity()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_slabs.size() * m_blocksPerSlab;
+    }
+
+    void MemoryPool::AllocateSlab()
+    {
+        PROFILE_FUNCTION();
+
+        u8 *slab = static_cast<u8 *>(
+            ::operator new(m_blockSize * m_blocksPerSlab, std::align_val_t(m_blockAlign)));
+        m_slabs.push_back(slab);
+
+        // the blocks are linked in the address order so the objects which
+        //      are created together are placed next to each other
+        for (i32 i = m_blocksPerSlab - 1; i >= 0; i--)
+        {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(slab + i * m_blockSize);
+            block->next = m_freeList;
+            m_freeList = block;
+        }
+    }
+} // namespace ntt
@@ -6,6 +6,7 @@
 #include <NTTEngine/structures/list.hpp>
 #include <NTTEngine/core/formatter.hpp>
 #include <fstream>
+#include <mutex>
 
 namespace ntt
 {
@@ -19,8 +20,9 @@ namespace ntt
         String s_outputFolder = RelativePath(".");
         b8 s_hasWritten = FALSE;
         b8 s_test = FALSE;
-        u8 s_indent = -1;
+        thread_local u8 s_indent = -1; ///< each thread has its own nesting level
         Scope<std::ofstream> s_stream;
+        std::mutex s_streamMutex;
     } // namespace
 
     class Profiling::Impl
@@ -60,6 +62,8 @@ namespace ntt
 
         String logFile = JoinPath({CurrentDirectory(), (s_currentSection + ".prof.txt")});
 
+        std::lock_guard<std::mutex> lock(s_streamMutex);
+
         try
         {
             if (!s_hasWritten)
@@ -106,6 +110,8 @@ namespace ntt
             data = format("\t{}", data);
         }
 
+        std::lock_guard<std::mutex> lock(s_streamMutex);
+
         try
         {
             if (s_stream == nullptr)
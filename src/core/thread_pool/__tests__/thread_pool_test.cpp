@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <NTTEngine/core/thread_pool.hpp>
+#include <atomic>
+#include <stdexcept>
+
+using namespace ntt;
+
+class ThreadPoolTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ThreadPoolInit(3);
+    }
+
+    void TearDown() override
+    {
+        ThreadPoolShutdown();
+    }
+};
+
+TEST_F(ThreadPoolTest, RunAllJobs)
+{
+    EXPECT_EQ(ThreadPoolGetWorkersCount(), 3);
+
+    std::atomic<u32> counter(0);
+    List<Job> jobs;
+
+    for (u32 i = 0; i < 100; i++)
+    {
+        jobs.push_back([&counter]()
+                       { counter++; });
+    }
+
+    ThreadPoolRun(jobs);
+    EXPECT_EQ(counter, 100);
+
+    ThreadPoolRun(jobs);
+    EXPECT_EQ(counter, 200);
+}
+
+TEST_F(ThreadPoolTest, ErrorJobDoesNotStopOtherJobs)
+{
+    std::atomic<u32> counter(0);
+    List<Job> jobs;
+
+    jobs.push_back([]()
+                   { throw std::runtime_error("Job error"); });
+    jobs.push_back([&counter]()
+                   { counter++; });
+    jobs.push_back([&counter]()
+                   { counter++; });
+
+    ThreadPoolRun(jobs);
+    EXPECT_EQ(counter, 2);
+}
+
+TEST(ThreadPoolWithoutWorkersTest, RunJobsOnTheCallingThread)
+{
+    ThreadPoolInit(1);
+    ThreadPoolShutdown();
+
+    EXPECT_EQ(ThreadPoolGetWorkersCount(), 0);
+
+    u32 counter = 0;
+    List<Job> jobs;
+    jobs.push_back([&counter]()
+                   { counter++; });
+    jobs.push_back([&counter]()
+                   { counter += 2; });
+
+    ThreadPoolRun(jobs);
+    EXPECT_EQ(counter, 3);
+}
+
+TEST_F(ThreadPoolTest, BackgroundJobsAreFinishedBeforeShutdown)
+{
+    std::atomic<u32> counter(0);
+
+    for (u32 i = 0; i < 20; i++)
+    {
+        ThreadPoolSubmit([&counter]()
+                         { counter++; });
+    }
+
+    ThreadPoolSubmit([]()
+                     { throw std::runtime_error("Background job error"); });
+
+    // the frame jobs are not blocked by the background jobs
+    u32 frameCounter = 0;
+    List<Job> jobs;
+    jobs.push_back([&frameCounter]()
+                   { frameCounter++; });
+
+    ThreadPoolRun(jobs);
+    EXPECT_EQ(frameCounter, 1);
+
+    ThreadPoolShutdown();
+    EXPECT_EQ(counter, 20);
+}
@@ -0,0 +1,226 @@
+#include <NTTEngine/core/thread_pool.hpp>
+#include <NTTEngine/core/logging/logging.hpp>
+#include <NTTEngine/core/profiling.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace ntt
+{
+    namespace
+    {
+        List<std::thread> s_workers;
+        std::deque<const Job *> s_jobs;
+        std::deque<Job> s_backgroundJobs;
+        u32 s_unfinishedJobs = 0;
+        b8 s_running = FALSE;
+
+        std::mutex s_mutex;
+        std::condition_variable s_jobAvailable;
+        std::condition_variable s_jobsFinished;
+
+        void ExecuteJob(const Job &job)
+        {
+            try
+            {
+                job();
+            }
+            catch (const std::exception &e)
+            {
+                NTT_ENGINE_ERROR("Error in the thread pool job: {}", e.what());
+            }
+            catch (...)
+            {
+                NTT_ENGINE_ERROR("Unknown error in the thread pool job");
+            }
+        }
+
+        void RunJob(const Job *job)
+        {
+            ExecuteJob(*job);
+
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_unfinishedJobs--;
+
+            if (s_unfinishedJobs == 0)
+            {
+                s_jobsFinished.notify_all();
+            }
+        }
+
+        void WorkerLoop()
+        {
+            while (TRUE)
+            {
+                const Job *job = nullptr;
+                Job backgroundJob;
+
+                {
+                    std::unique_lock<std::mutex> lock(s_mutex);
+                    s_jobAvailable.wait(lock, []
+                                        { return !s_running ||
+                                                 !s_jobs.empty() ||
+                                                 !s_backgroundJobs.empty(); });
+
+                    if (!s_jobs.empty())
+                    {
+                        job = s_jobs.front();
+                        s_jobs.pop_front();
+                    }
+                    else if (!s_backgroundJobs.empty())
+                    {
+                        backgroundJob = std::move(s_backgroundJobs.front());
+                        s_backgroundJobs.pop_front();
+                    }
+                    else
+                    {
+                        return;
+                    }
+                }
+
+                if (job != nullptr)
+                {
+                    RunJob(job);
+                }
+                else
+                {
+                    ExecuteJob(backgroundJob);
+                }
+            }
+        }
+    } // namespace
+
+    void ThreadPoolInit(u32 workersCount)
+    {
+        PROFILE_FUNCTION();
+
+        if (s_running)
+        {
+            NTT_ENGINE_WARN("The thread pool is already initialized");
+            return;
+        }
+
+        if (workersCount == 0)
+        {
+            u32 hardwareThreads = std::thread::hardware_concurrency();
+            workersCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
+        s_running = TRUE;
+        s_unfinishedJobs = 0;
+
+        for (u32 i = 0; i < workersCount; i++)
+        {
+            s_workers.push_back(std::thread(WorkerLoop));
+        }
+
+        NTT_ENGINE_DEBUG("The thread pool is started with {} workers", workersCount);
+    }
+
+    u32 ThreadPoolGetWorkersCount()
+    {
+        return s_workers.size();
+    }
+
+    void ThreadPoolRun(const List<Job> &jobs)
+    {
+        PROFILE_FUNCTION();
+
+        if (jobs.empty())
+        {
+            return;
+        }
+
+        if (s_workers.empty() || jobs.size() == 1)
+        {
+            for (auto &job : jobs)
+            {
+                s_unfinishedJobs++;
+                RunJob(&job);
+            }
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+
+            for (auto &job : jobs)
+            {
+                s_jobs.push_back(&job);
+            }
+
+            s_unfinishedJobs += jobs.size();
+        }
+
+        s_jobAvailable.notify_all();
+
+        // the calling thread helps the workers instead of only waiting
+        while (TRUE)
+        {
+            const Job *job = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+
+                if (s_jobs.empty())
+                {
+                    break;
+                }
+
+                job = s_jobs.front();
+                s_jobs.pop_front();
+            }
+
+            RunJob(job);
+        }
+
+        std::unique_lock<std::mutex> lock(s_mutex);
+        s_jobsFinished.wait(lock, []
+                            { return s_unfinishedJobs == 0; });
+    }
+
+    void ThreadPoolSubmit(const Job &job)
+    {
+        PROFILE_FUNCTION();
+
+        if (s_workers.empty())
+        {
+            ExecuteJob(job);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_backgroundJobs.push_back(job);
+        }
+
+        s_jobAvailable.notify_one();
+    }
+
+    void ThreadPoolShutdown()
+    {
+        PROFILE_FUNCTION();
+
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_running = FALSE;
+        }
+
+        s_jobAvailable.notify_all();
+
+        for (auto &worker : s_workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+
+        s_workers.clear();
+        s_jobs.clear();
+        s_backgroundJobs.clear();
+        s_unfinishedJobs = 0;
+    }
+} // namespace ntt
@@ -62,7 +62,7 @@ TEST_F(StoreTest, HappyPath)
 
     EXPECT_EQ(store.Get(id3) == nullptr, true);
 
-    EXPECT_TRUE(store.GetAvailableIds() == List<u32>({0, 2, 3}));
+    EXPECT_THAT(store.GetAvailableIds(), ::testing::UnorderedElementsAre(0, 2, 3));
 
     auto id6 = store.Add(obj6);
     EXPECT_EQ(id6, 1);
@@ -71,11 +71,11 @@ TEST_F(StoreTest, HappyPath)
     store.Release(id4);
     store.Release(23);
 
-    EXPECT_TRUE(store.GetAvailableIds() == List<u32>({1, 3}));
+    EXPECT_THAT(store.GetAvailableIds(), ::testing::UnorderedElementsAre(1, 3));
 
     EXPECT_EQ(store.Add(CreateRef<TestObj>(1, "obj1")), 0);
 
-    EXPECT_TRUE(store.GetAvailableIds() == List<u32>({0, 1, 3}));
+    EXPECT_THAT(store.GetAvailableIds(), ::testing::UnorderedElementsAre(0, 1, 3));
 
     EXPECT_EQ(store.Add(CreateRef<TestObj>(44, "obj1")), 2);
 }
@@ -89,21 +89,27 @@ TEST_F(StoreTest, TestForEach)
     auto id5 = store.Add(CreateRef<TestObj>(5, "obj5"));
     auto id6 = store.Add(CreateRef<TestObj>(6, "obj6"));
 
-    String result = "";
+    List<String> result = {};
 
     store.ForEach([&result](Ref<TestObj> obj, const u32 id)
-                  { result += obj->name + "; "; });
+                  { result.push_back(obj->name); });
 
-    EXPECT_EQ(result, "obj1; obj2; obj4; obj5; obj6; ");
+    EXPECT_THAT(result, ::testing::UnorderedElementsAre("obj1", "obj2", "obj4", "obj5", "obj6"));
 
     store.Release(id3);
 
-    result = "";
+    result = {};
 
     store.ForEach([&result](Ref<TestObj> obj, const u32 id)
-                  { result += obj->name + "; "; });
+                  { result.push_back(obj->name); });
 
-    EXPECT_EQ(result, "obj1; obj4; obj5; obj6; ");
+    EXPECT_THAT(result, ::testing::UnorderedElementsAre("obj1", "obj4", "obj5", "obj6"));
+
+    // the objects can be released while iterating
+    store.ForEach([this](Ref<TestObj> obj, const u32 id)
+                  { store.Release(id); });
+
+    EXPECT_EQ(store.Count(), 0);
 }
 
 TEST_F(StoreTest, MaxCondition)
@@ -119,4 +125,36 @@ TEST_F(StoreTest, MaxCondition)
     store.Add(CreateRef<TestObj>(9, "obj9"));
     store.Add(CreateRef<TestObj>(10, "obj10"));
     EXPECT_THAT(store.Add(CreateRef<TestObj>(11, "obj11")), 0);
-}
\ No newline at end of file
+}
+
+TEST(StoreKeyIndexTest, ObjectsAreIndexedByKey)
+{
+    Store<u32, TestObj> store{
+        0, 10,
+        [](Ref<TestObj> obj, Ref<TestObj> other) -> b8
+        { return obj->name == other->name; },
+        [](Ref<TestObj> obj) -> String
+        { return obj->name; }};
+
+    auto first = store.Add(CreateRef<TestObj>(1, "first"));
+    auto second = store.Add(CreateRef<TestObj>(2, "second"));
+
+    // the object with the same key is not added again
+    EXPECT_EQ(store.Add(CreateRef<TestObj>(3, "first")), first);
+    EXPECT_EQ(store.Count(), 2);
+
+    EXPECT_THAT(store.GetIdsByKey("first"), ::testing::ElementsAre(first));
+    EXPECT_EQ(store.GetByKey("second")->data, 2);
+    EXPECT_TRUE(store.GetIdsByKey("third").empty());
+
+    store.Release(first);
+
+    EXPECT_TRUE(store.GetIdsByKey("first").empty());
+    EXPECT_EQ(store.GetByKey("first"), nullptr);
+    EXPECT_EQ(store.GetByKey("second")->data, 2);
+
+    auto third = store.Add(CreateRef<TestObj>(3, "first"));
+    EXPECT_EQ(third, first);
+    EXPECT_EQ(store.GetByKey("first")->data, 3);
+    EXPECT_NE(third, second);
+}
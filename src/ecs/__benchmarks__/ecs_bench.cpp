@@ -0,0 +1,135 @@
+#include <NTTEngine/dev/benchmark.hpp>
+
+#include <NTTEngine/ecs/ecs.hpp>
+#include <NTTEngine/application/event_system/event_system.hpp>
+#include <NTTEngine/application/input_system/input_system.hpp>
+#include <NTTEngine/renderer/renderer.hpp>
+#include <NTTEngine/renderer/Geometry.hpp>
+#include <NTTEngine/renderer/Parent.hpp>
+#include <NTTEngine/renderer/ParentSystem.hpp>
+#include <NTTEngine/renderer/RenderSystem.hpp>
+#include <NTTEngine/renderer/GraphicInterface.hpp>
+#include <NTTEngine/physics/Mass.hpp>
+#include <NTTEngine/physics/MassSystem.hpp>
+#include <NTTEngine/physics/collision.hpp>
+#include <NTTEngine/physics/collision_system.hpp>
+
+using namespace ntt;
+
+NTT_BENCHMARK(CreateDeleteEntities, 100, 1000, 10000)
+{
+    EventInit();
+    ECSInit();
+    ECSBeginLayer(GAME_LAYER);
+    ECSLayerMakeVisible(GAME_LAYER);
+
+    List<entity_id_t> entities;
+    entities.reserve(bench.Argument());
+
+    bench.SetItemsCount(bench.Argument());
+    bench.Run(
+        [&]()
+        {
+            for (u32 i = 0; i < bench.Argument(); i++)
+            {
+                entities.push_back(ECSCreateEntity(
+                    "entity",
+                    {ECS_CREATE_COMPONENT(Geometry, 10.0f, 10.0f, 5.0f, 5.0f),
+                     ECS_CREATE_COMPONENT(Mass)}));
+            }
+
+            for (auto entity : entities)
+            {
+                ECSDeleteEntity(entity);
+            }
+
+            entities.clear();
+        });
+
+    ECSShutdown();
+    EventShutdown();
+}
+
+NTT_BENCHMARK(ECSUpdateStockSystems, 1000, 10000)
+{
+    EventInit();
+    InputInit(TRUE);
+    RendererInit(TRUE);
+    AddCamera(Position{400, 300}, Size{800, 600});
+    ECSInit();
+
+    // the same systems as the application (except the scripts, which need
+    //      the hot reload module)
+    ECSRegister(
+        "Parent System",
+        CreateRef<ParentSystem>(),
+        {typeid(Parent)},
+        TRUE,
+        SystemAccess({typeid(Parent), typeid(Geometry)}, {typeid(Geometry)}));
+
+    ECSRegister(
+        "Render System",
+        CreateRef<RenderSystem>(),
+        {typeid(Geometry)},
+        TRUE);
+
+    ECSRegister(
+        COLLISION_NAME,
+        CreateRef<CollisionSystem>(),
+        {typeid(Geometry), typeid(Collision)});
+
+    ECSRegister(
+        "Mass System",
+        CreateRef<MassSystem>(),
+        {typeid(Mass), typeid(Geometry)},
+        FALSE,
+        SystemAccess({}, {typeid(Mass), typeid(Geometry)}, TRUE));
+
+    ECSBeginLayer(GAME_LAYER);
+    ECSLayerMakeVisible(GAME_LAYER);
+
+    entity_id_t root = INVALID_ENTITY_ID;
+
+    for (u32 i = 0; i < bench.Argument(); i++)
+    {
+        f32 x = static_cast<f32>(i % 100) * 8;
+        f32 y = static_cast<f32>(i / 100 % 75) * 8;
+
+        if (i % 10 == 0)
+        {
+            // a few colliding bodies and the roots of the hierarchies
+            root = ECSCreateEntity(
+                "root",
+                {ECS_CREATE_COMPONENT(Geometry, x, y, 6.0f, 6.0f),
+                 ECS_CREATE_COMPONENT(Mass, 1.0f, 0.1f, 0.1f),
+                 ECS_CREATE_COMPONENT(Collision)});
+        }
+        else if (i % 4 == 0)
+        {
+            ECSCreateEntity(
+                "child",
+                {ECS_CREATE_COMPONENT(Geometry, x, y, 4.0f, 4.0f),
+                 ECS_CREATE_COMPONENT(Parent, root, 2.0f, 2.0f)});
+        }
+        else
+        {
+            ECSCreateEntity(
+                "body",
+                {ECS_CREATE_COMPONENT(Geometry, x, y, 4.0f, 4.0f),
+                 ECS_CREATE_COMPONENT(Mass, 1.0f, 0.1f, 0.0f)});
+        }
+    }
+
+    bench.SetItemsCount(bench.Argument());
+    bench.Run(
+        [&]()
+        {
+            ECSUpdate(16.0f);
+            GraphicUpdate();
+        });
+
+    ECSShutdown();
+    RendererShutdown();
+    InputShutdown();
+    EventShutdown();
+}
@@ -4,6 +4,13 @@
 #include <NTTEngine/ecs/ecs.hpp>
 #include <NTTEngine/application/event_system/event_system.hpp>
 #include <NTTEngine/renderer/Geometry.hpp>
+#include <NTTEngine/physics/Mass.hpp>
+#include <NTTEngine/physics/MassSystem.hpp>
+#include <NTTEngine/renderer/Parent.hpp>
+#include <NTTEngine/core/thread_pool.hpp>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
 
 using namespace ntt;
 
@@ -34,6 +41,11 @@ public:
     {
         return "TestData";
     }
+
+    Ref<ComponentBase> Clone() const override
+    {
+        return CreateRef<TestData>(*this);
+    }
 };
 
 struct NonTestData : public ComponentBase
@@ -46,6 +58,11 @@ struct NonTestData : public ComponentBase
     {
         return "NonTestData";
     }
+
+    Ref<ComponentBase> Clone() const override
+    {
+        return CreateRef<NonTestData>(*this);
+    }
 };
 
 struct TestLayerData : public ComponentBase
@@ -615,4 +632,918 @@ TEST_F(ECSTest, CreateEntityWithPriority)
 
     auto textEntGeo2 = ECS_GET_COMPONENT(textEnt2, Geometry);
     EXPECT_EQ(textEntGeo2->priority, PRIORITY_1 + LAYER_PRIORITY_RANGE * UI_LAYER);
-}
\ No newline at end of file
+}
+TEST_F(ECSTest, DeleteEntityKeepsOtherComponentsOfTheSameSignature)
+{
+    auto entity3 = ECSCreateEntity(
+        "TestEntity3",
+        {ECS_CREATE_COMPONENT(TestData)});
+    auto data3 = ECS_GET_COMPONENT(entity3, TestData);
+
+    ECSDeleteEntity(entity);
+
+    EXPECT_EQ(ECS_GET_COMPONENT(entity, TestData), nullptr);
+    EXPECT_EQ(ECS_GET_COMPONENT(entity2, TestData), data2);
+    EXPECT_EQ(ECS_GET_COMPONENT(entity3, TestData), data3);
+    EXPECT_EQ(ECS_GET_COMPONENT(entity3, NonTestData), nullptr);
+
+    auto entityInfo = ECSGetEntity(entity3);
+    EXPECT_EQ(entityInfo->name, "TestEntity3");
+    EXPECT_EQ(entityInfo->components.size(), 2);
+    EXPECT_TRUE(entityInfo->components.Contains(typeid(TestData)));
+    EXPECT_TRUE(entityInfo->components.Contains(typeid(DataComponent)));
+
+    ECSUpdate(0.0f);
+    EXPECT_EQ(data2->updateCalled, 1);
+    EXPECT_EQ(data3->updateCalled, 1);
+}
+
+namespace
+{
+    u8 s_batchCalled = 0;
+    List<entity_id_t> s_batchEntities = {};
+}
+
+class TestBatchSystem : public System
+{
+public:
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override {}
+    void UpdateBatch(f32 delta, Span<const entity_id_t> ids) override
+    {
+        s_batchCalled++;
+        for (auto id : ids)
+        {
+            s_batchEntities.push_back(id);
+        }
+    }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+};
+
+TEST_F(ECSTest, BatchedSystemReceivesAllEntitiesAtOnce)
+{
+    s_batchCalled = 0;
+    s_batchEntities = {};
+
+    ECSRegister("TestBatchSystem", CreateRef<TestBatchSystem>(), {typeid(TestData)});
+
+    auto entity3 = ECSCreateEntity(
+        "TestEntity3",
+        {ECS_CREATE_COMPONENT(TestData)});
+
+    ECSUpdate(0.0f);
+
+    EXPECT_EQ(s_batchCalled, 1);
+    EXPECT_EQ(s_batchEntities, List<entity_id_t>({entity3}));
+
+    // the per-entity systems still work through the default adapter
+    EXPECT_EQ(data->updateCalled, 1);
+    EXPECT_EQ(data2->updateCalled, 1);
+}
+
+namespace
+{
+    std::atomic<u32> s_parallelUpdated(0);
+}
+
+class TestParallelSystem : public System
+{
+public:
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override
+    {
+        s_parallelUpdated++;
+    }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+};
+
+TEST_F(ECSTest, DeclaredSystemsAreUpdatedByTheThreadPool)
+{
+    ThreadPoolInit(3);
+    s_parallelUpdated = 0;
+
+    ECSRegister(
+        "TestParallelSystem1",
+        CreateRef<TestParallelSystem>(),
+        {typeid(TestLayerData)},
+        FALSE,
+        SystemAccess({}, {typeid(TestLayerData)}, TRUE));
+    ECSRegister(
+        "TestParallelSystem2",
+        CreateRef<TestParallelSystem>(),
+        {typeid(TestLayerData)},
+        FALSE,
+        SystemAccess({typeid(TestLayerData)}, {}));
+
+    for (u32 i = 0; i < 600; i++)
+    {
+        ECSCreateEntity(
+            format("ParallelEntity{}", i),
+            {ECS_CREATE_COMPONENT(TestLayerData)});
+    }
+
+    ECSUpdate(0.0f);
+
+    // both systems are registered after the fixture entities were created
+    //      so only the new entities are updated by them
+    EXPECT_EQ(s_parallelUpdated, 1200);
+
+    ThreadPoolShutdown();
+}
+
+namespace
+{
+    std::mutex s_parallelSpawnedMutex;
+    List<entity_id_t> s_parallelSpawned = {};
+}
+
+class TestParallelSpawnSystem : public System
+{
+public:
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override
+    {
+        auto spawned = ECSCreateEntity(
+            "ParallelSpawnedEntity",
+            {ECS_CREATE_COMPONENT(TestData)});
+
+        // the entity is only reserved while the other chunks are running
+        EXPECT_EQ(ECS_GET_COMPONENT(spawned, TestData), nullptr);
+
+        std::lock_guard<std::mutex> lock(s_parallelSpawnedMutex);
+        s_parallelSpawned.push_back(spawned);
+    }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+};
+
+TEST_F(ECSTest, EntitiesCreatedByParallelSystemsAreInsertedAtTheEndOfTheFrame)
+{
+    ThreadPoolInit(3);
+    s_parallelSpawned = {};
+
+    ECSRegister(
+        "TestParallelSpawnSystem",
+        CreateRef<TestParallelSpawnSystem>(),
+        {typeid(TestLayerData)},
+        FALSE,
+        SystemAccess({typeid(TestLayerData)}, {}, TRUE));
+
+    for (u32 i = 0; i < 1000; i++)
+    {
+        ECSCreateEntity(
+            format("ParallelSpawner{}", i),
+            {ECS_CREATE_COMPONENT(TestLayerData)});
+    }
+
+    ECSUpdate(0.0f);
+
+    EXPECT_EQ(s_parallelSpawned.size(), 1000);
+
+    List<entity_id_t> ids = s_parallelSpawned;
+    ids.Sorted();
+    EXPECT_EQ(std::unique(ids.begin(), ids.end()), ids.end());
+
+    for (auto id : s_parallelSpawned)
+    {
+        ASSERT_NE(id, INVALID_ENTITY_ID);
+        EXPECT_NE(ECS_GET_COMPONENT(id, TestData), nullptr);
+    }
+
+    // the reserved slots are not given to the entities which are created later
+    auto created = ECSCreateEntity("AfterSpawn", {ECS_CREATE_COMPONENT(TestData)});
+    EXPECT_FALSE(ids.Contains(created));
+
+    ThreadPoolShutdown();
+}
+
+namespace
+{
+    List<entity_id_t> s_spawnedEntities = {};
+}
+
+class TestSpawnSystem : public System
+{
+public:
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override
+    {
+        auto spawned = ECSCreateEntity(
+            "SpawnedEntity",
+            {ECS_CREATE_COMPONENT(TestData)});
+        s_spawnedEntities.push_back(spawned);
+
+        ECSDeleteEntity(id);
+    }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+};
+
+TEST_F(ECSTest, StructuralChangesInUpdateAreAppliedAtTheEndOfTheFrame)
+{
+    s_spawnedEntities = {};
+
+    ECSRegister("TestSpawnSystem", CreateRef<TestSpawnSystem>(), {typeid(NonTestData)});
+
+    auto spawner = ECSCreateEntity(
+        "Spawner",
+        {ECS_CREATE_COMPONENT(NonTestData)});
+
+    ECSUpdate(0.0f);
+
+    EXPECT_EQ(s_spawnedEntities.size(), 1);
+    EXPECT_FALSE(ECSIsEntityValid(spawner));
+    EXPECT_EQ(ECSGetEntity(spawner), nullptr);
+
+    auto spawned = s_spawnedEntities[0];
+    EXPECT_TRUE(ECSIsEntityValid(spawned));
+    EXPECT_THAT(ECSGetEntitiesWithSystem(TEST_SYSTEM_NAME), ::testing::Contains(spawned));
+    EXPECT_THAT(ECS_GetAllEntitiesIn(GAME_LAYER), ::testing::Contains(spawned));
+
+    // the spawned entity is updated from the next frame
+    auto spawnedData = ECS_GET_COMPONENT(spawned, TestData);
+    EXPECT_EQ(spawnedData->updateCalled, 0);
+    ECSUpdate(0.0f);
+    EXPECT_EQ(spawnedData->updateCalled, 1);
+    EXPECT_EQ(s_spawnedEntities.size(), 1);
+}
+
+TEST_F(ECSTest, DeletedEntityIdDoesNotReferToTheReusedSlot)
+{
+    ECSDeleteEntity(entity);
+    EXPECT_FALSE(ECSIsEntityValid(entity));
+
+    List<entity_id_t> newEntities = {};
+    for (u32 i = 0; i < 5; i++)
+    {
+        newEntities.push_back(ECSCreateEntity(
+            format("NewEntity{}", i),
+            {ECS_CREATE_COMPONENT(TestData)}));
+    }
+
+    // one of the new entities reuses the slot of the deleted entity
+    b8 isSlotReused = FALSE;
+    for (auto newEntity : newEntities)
+    {
+        EXPECT_NE(newEntity, entity);
+        if (EntityIndex(newEntity) == EntityIndex(entity))
+        {
+            isSlotReused = TRUE;
+            EXPECT_EQ(EntityGeneration(newEntity), EntityGeneration(entity) + 1);
+        }
+    }
+    EXPECT_TRUE(isSlotReused);
+
+    EXPECT_FALSE(ECSIsEntityValid(entity));
+    EXPECT_EQ(ECSGetEntity(entity), nullptr);
+    EXPECT_EQ(ECS_GET_COMPONENT(entity, TestData), nullptr);
+    EXPECT_THAT(ECSGetEntitiesWithSystem(TEST_SYSTEM_NAME),
+                ::testing::Not(::testing::Contains(entity)));
+
+    // deleting with the old id does nothing to the new entity
+    ECSDeleteEntity(entity);
+    for (auto newEntity : newEntities)
+    {
+        EXPECT_TRUE(ECSIsEntityValid(newEntity));
+    }
+}
+
+TEST_F(ECSTest, QueryVisitsEntitiesWithAllComponents)
+{
+    auto entity3 = ECSCreateEntity(
+        "TestEntity3",
+        {ECS_CREATE_COMPONENT(TestData), ECS_CREATE_COMPONENT(NonTestData)});
+
+    EXPECT_EQ(ECSQuery<TestData>().Count(), 3);
+    EXPECT_EQ(ECSQuery<NonTestData>().Count(), 2);
+    EXPECT_EQ((ECSQuery<TestData, NonTestData>().Count()), 1);
+    EXPECT_EQ(ECSQuery<TestLayerData>().Count(), 0);
+
+    List<entity_id_t> visited = {};
+    ECSForEach<NonTestData, TestData>(
+        [&visited](entity_id_t id, NonTestData &nonTestData, TestData &testData)
+        {
+            visited.push_back(id);
+            testData.updateCalled = 10;
+            nonTestData.updateCalled = 20;
+        });
+
+    EXPECT_EQ(visited, List<entity_id_t>({entity3}));
+    EXPECT_EQ(ECS_GET_COMPONENT(entity3, TestData)->updateCalled, 10);
+    EXPECT_EQ(ECS_GET_COMPONENT(entity3, NonTestData)->updateCalled, 20);
+
+    // the inactive components are skipped like the systems do
+    ECSSetComponentActive(entity, typeid(TestData), FALSE);
+    EXPECT_EQ(ECSQuery<TestData>().Count(), 2);
+}
+
+TEST_F(ECSTest, DeleteAndCreateInsideQuery)
+{
+    List<entity_id_t> created = {};
+
+    ECSForEach<TestData>(
+        [&created](entity_id_t id, TestData &testData)
+        {
+            ECSDeleteEntity(id);
+            created.push_back(ECSCreateEntity(
+                "CreatedInQuery",
+                {ECS_CREATE_COMPONENT(TestData)}));
+
+            // the deletion is applied after the query
+            EXPECT_FALSE(ECSIsEntityValid(id));
+            EXPECT_NE(ECS_GET_COMPONENT(id, TestData), nullptr);
+        });
+
+    EXPECT_EQ(created.size(), 2);
+    EXPECT_FALSE(ECSIsEntityValid(entity));
+    EXPECT_FALSE(ECSIsEntityValid(entity2));
+    EXPECT_EQ(ECSQuery<TestData>().Count(), 2);
+    Check2ListEquivalent(ECSGetEntitiesWithSystem(TEST_SYSTEM_NAME), created);
+}
+
+TEST_F(ECSTest, CreateManyEntitiesAtOnce)
+{
+    List<Ref<EntityInfo>> infos = {};
+
+    for (u32 i = 0; i < 100; i++)
+    {
+        auto info = CreateRef<EntityInfo>();
+        info->name = format("BulkEntity{}", i);
+
+        if (i % 2 == 0)
+        {
+            info->components[typeid(TestData)] = CreateRef<TestData>();
+        }
+        else
+        {
+            info->components[typeid(NonTestData)] = CreateRef<NonTestData>();
+        }
+
+        infos.push_back(info);
+    }
+
+    auto ids = ECSCreateEntities(infos);
+
+    EXPECT_EQ(ids.size(), 100);
+    EXPECT_EQ(ECSQuery<TestData>().Count(), 52);
+    EXPECT_EQ(ECSQuery<NonTestData>().Count(), 51);
+    EXPECT_EQ(ECSGetEntitiesWithSystem(TEST_SYSTEM_NAME).size(), 52);
+    EXPECT_EQ(ECS_GetAllEntitiesIn(GAME_LAYER).size(), 103);
+
+    for (u32 i = 0; i < ids.size(); i++)
+    {
+        EXPECT_TRUE(ECSIsEntityValid(ids[i]));
+        EXPECT_EQ(ECSGetEntityByName(format("BulkEntity{}", i)), ids[i]);
+        EXPECT_NE(ECS_GET_COMPONENT(ids[i], DataComponent), nullptr);
+
+        // the given components are attached as is
+        EXPECT_EQ(infos[i]->components.begin()->second->entity_id, ids[i]);
+
+        if (i % 2 == 0)
+        {
+            EXPECT_EQ(ECS_GET_COMPONENT(ids[i], TestData)->initCalled, 1);
+        }
+    }
+
+    // the given entity infos are not changed
+    EXPECT_EQ(infos[0]->components.size(), 1);
+}
+
+TEST_F(ECSTest, InstantiatePrefab)
+{
+    auto prototype = CreateRef<TestData>();
+    prototype->updateCalled = 5;
+
+    ECSRegisterPrefab("Enemy", {{typeid(TestData), prototype}, ECS_CREATE_COMPONENT(NonTestData)});
+    EXPECT_TRUE(ECSHasPrefab("Enemy"));
+
+    // the prefab keeps its own copy of the prototype
+    prototype->updateCalled = 7;
+
+    auto ids = ECSInstantiatePrefab("Enemy", 10);
+    EXPECT_EQ(ids.size(), 10);
+    EXPECT_EQ((ECSQuery<TestData, NonTestData>().Count()), 10);
+
+    // the components are not shared between the instances
+    auto data1 = ECS_GET_COMPONENT(ids[0], TestData);
+    auto data2 = ECS_GET_COMPONENT(ids[1], TestData);
+    EXPECT_NE(data1, data2);
+    EXPECT_EQ(data1->updateCalled, 5);
+    EXPECT_EQ(data1->initCalled, 1);
+    EXPECT_EQ(data2->initCalled, 1);
+    EXPECT_EQ(data1->entity_id, ids[0]);
+
+    EXPECT_EQ(ECSInstantiatePrefab("NotExisted", 3).size(), 0);
+
+    ECSRemovePrefab("Enemy");
+    EXPECT_FALSE(ECSHasPrefab("Enemy"));
+}
+
+TEST_F(ECSTest, InstantiatePrefabFromJSON)
+{
+    ECSRegisterPrefab(
+        "Rock",
+        JSON(R"({"Mass": {"mass": 2.5, "velocity_x": 1, "velocity_y": 0, "acc_x": 0, "acc_y": 0}})"));
+
+    auto ids = ECSInstantiatePrefab("Rock", 3);
+    EXPECT_EQ(ids.size(), 3);
+
+    for (auto id : ids)
+    {
+        auto mass = ECS_GET_COMPONENT(id, Mass);
+        ASSERT_NE(mass, nullptr);
+        EXPECT_FLOAT_EQ(mass->mass, 2.5f);
+        EXPECT_FLOAT_EQ(mass->velocity_x, 1.0f);
+    }
+
+    EXPECT_NE(ECS_GET_COMPONENT(ids[0], Mass), ECS_GET_COMPONENT(ids[1], Mass));
+}
+
+namespace
+{
+    List<entity_id_t> s_changedEntities = {};
+}
+
+class TestChangedSystem : public System
+{
+public:
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override
+    {
+        if (ECS_IS_CHANGED(id, NonTestData))
+        {
+            s_changedEntities.push_back(id);
+        }
+
+        // the own changes are not seen in the next update
+        ECS_MARK_CHANGED(id, NonTestData);
+    }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+};
+
+TEST_F(ECSTest, SystemOnlySeesTheChangesAfterItsLastUpdate)
+{
+    s_changedEntities = {};
+
+    ECSRegister("TestChangedSystem", CreateRef<TestChangedSystem>(), {typeid(NonTestData)});
+
+    auto changed = ECSCreateEntity(
+        "ChangedEntity",
+        {ECS_CREATE_COMPONENT(NonTestData)});
+    auto unchanged = ECSCreateEntity(
+        "UnchangedEntity",
+        {ECS_CREATE_COMPONENT(NonTestData)});
+
+    // all the components are new at the first update
+    ECSUpdate(0.0f);
+    EXPECT_THAT(s_changedEntities, ::testing::Contains(changed));
+    EXPECT_THAT(s_changedEntities, ::testing::Contains(unchanged));
+
+    s_changedEntities = {};
+    ECSUpdate(0.0f);
+    EXPECT_TRUE(s_changedEntities.empty());
+
+    // reading does not mark the component, fetching it mutably does
+    EXPECT_NE(ECS_READ_COMPONENT(unchanged, NonTestData), nullptr);
+    ECS_GET_COMPONENT(changed, NonTestData)->updateCalled = 5;
+
+    ECSUpdate(0.0f);
+    EXPECT_EQ(s_changedEntities, List<entity_id_t>({changed}));
+}
+
+class TestReaderSystem : public System
+{
+public:
+    u32 readCount = 0;
+
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override
+    {
+        readCount += ECS_GET_COMPONENT(id, NonTestData)->initCalled;
+    }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+};
+
+TEST_F(ECSTest, DeclaredReadsAreNotMarkedAsChanged)
+{
+    ECSRegister("TestReaderSystem", CreateRef<TestReaderSystem>(), {typeid(NonTestData)},
+                FALSE, SystemAccess({typeid(NonTestData)}, {}));
+
+    auto read = ECSCreateEntity("ReadEntity", {ECS_CREATE_COMPONENT(NonTestData)});
+    ECSUpdate(0.0f);
+    auto tick = ECSGetChangeTick();
+
+    ECSUpdate(0.0f);
+    EXPECT_EQ(ECSQuery<const NonTestData>().Filter(Changed<NonTestData>(tick)).Count(), 0);
+
+    // outside the systems the fetched component is still marked
+    ECS_GET_COMPONENT(read, NonTestData);
+    EXPECT_EQ(ECSQuery<const NonTestData>().Filter(Changed<NonTestData>(tick)).Count(), 1);
+}
+
+TEST_F(ECSTest, QueryFiltersChangedAndAddedComponents)
+{
+    ECSUpdate(0.0f);
+    auto tick = ECSGetChangeTick();
+
+    EXPECT_EQ(ECSQuery<const TestData>().Filter(Changed<TestData>(tick)).Count(), 0);
+    EXPECT_EQ(ECSQuery<const TestData>().Filter(Added<TestData>(tick)).Count(), 0);
+
+    auto added = ECSCreateEntity(
+        "AddedEntity",
+        {ECS_CREATE_COMPONENT(TestData)});
+    EXPECT_EQ(ECSQuery<const TestData>().Filter(Added<TestData>(tick)).Count(), 1);
+
+    // the const query does not mark the visited components as changed
+    ECSForEach<const TestData>([](entity_id_t, const TestData &) {});
+    EXPECT_EQ(ECSQuery<const TestData>().Filter(Changed<TestData>(tick)).Count(), 1);
+
+    ECSForEach<TestData>([](entity_id_t, TestData &) {});
+    EXPECT_EQ(ECSQuery<const TestData>().Filter(Changed<TestData>(tick)).Count(), 3);
+
+    List<entity_id_t> visited = {};
+    ECSQuery<const TestData>()
+        .Filter(Added<TestData>(tick))
+        .Filter(Changed<TestData>(tick))
+        .ForEach([&visited](entity_id_t id, const TestData &)
+                 { visited.push_back(id); });
+    EXPECT_EQ(visited, List<entity_id_t>({added}));
+}
+
+TEST_F(ECSTest, QueryOverTheGivenEntitiesSkipsTheDeletedOnes)
+{
+    auto tick = ECSGetChangeTick();
+    List<entity_id_t> visited = {};
+
+    ECSForEach<const NonTestData>(
+        [&](entity_id_t, const NonTestData &)
+        {
+            // the deleted entity is still stored until the query is finished
+            ECSDeleteEntity(entity2);
+
+            List<entity_id_t> ids = {entity4, entity2, entity, INVALID_ENTITY_ID};
+            ECSQuery<TestData>().ForEach(
+                ids,
+                [&](entity_id_t id, TestData &)
+                { visited.push_back(id); });
+        });
+
+    EXPECT_EQ(visited, List<entity_id_t>({entity}));
+    EXPECT_EQ(ECSQuery<const TestData>().Filter(Changed<TestData>(tick)).Count(), 1);
+}
+
+TEST_F(ECSTest, ClearLayerInsideQueryKeepsTheVisitedRows)
+{
+    List<entity_id_t> visited = {};
+
+    ECSForEach<TestData>(
+        [&](entity_id_t id, TestData &testData)
+        {
+            ECS_ClearLayer(GAME_LAYER);
+
+            // the rows are still stored until the query is finished
+            testData.updateCalled++;
+            visited.push_back(id);
+            EXPECT_TRUE(ECSIsEntityValid(id));
+        });
+
+    Check2ListEquivalent(visited, {entity, entity2});
+    EXPECT_EQ(data->updateCalled, 1);
+    EXPECT_EQ(data2->updateCalled, 1);
+
+    EXPECT_FALSE(ECSIsEntityValid(entity));
+    EXPECT_FALSE(ECSIsEntityValid(entity2));
+    EXPECT_FALSE(ECSIsEntityValid(entity4));
+    EXPECT_EQ(ECS_GetAllEntitiesIn(GAME_LAYER).size(), 0);
+    EXPECT_EQ(ECSQuery<const TestData>().Count(), 0);
+}
+
+TEST_F(ECSTest, MassSystemOnlyMovesTheValidEntities)
+{
+    ECSRegister("MassSystem", CreateRef<MassSystem>(), {typeid(Mass), typeid(Geometry)});
+
+    auto moved = ECSCreateEntity(
+        "Moved",
+        {ECS_CREATE_COMPONENT(Geometry, 0, 0), ECS_CREATE_COMPONENT(Mass, 1.0f, 1.0f, 0.0f)});
+    auto deleted = ECSCreateEntity(
+        "Deleted",
+        {ECS_CREATE_COMPONENT(Geometry, 0, 0), ECS_CREATE_COMPONENT(Mass, 1.0f, 1.0f, 0.0f)});
+    auto deletedGeo = ECS_GET_COMPONENT(deleted, Geometry);
+
+    // only entity4 has the NonTestData
+    ECSForEach<const NonTestData>(
+        [&](entity_id_t, const NonTestData &)
+        {
+            ECSDeleteEntity(deleted);
+            CreateRef<MassSystem>()->UpdateBatch(10.0f, List<entity_id_t>({moved, deleted}));
+        });
+
+    EXPECT_FLOAT_EQ(ECS_GET_COMPONENT(moved, Geometry)->pos.x, 1.0f);
+    EXPECT_FLOAT_EQ(deletedGeo->pos.x, 0.0f);
+}
+
+TEST_F(ECSTest, RestoreSnapshotKeepsTheEntityIds)
+{
+    data->updateCalled = 7;
+    auto snapshot = ECSSnapshot({GAME_LAYER});
+
+    data->updateCalled = 100;
+    ECSDeleteEntity(entity);
+    auto created = ECSCreateEntity(
+        "CreatedAfterSnapshot",
+        {ECS_CREATE_COMPONENT(TestData)});
+
+    auto restored = ECSRestore(snapshot);
+
+    EXPECT_EQ(restored.size(), 3);
+    EXPECT_FALSE(ECSIsEntityValid(created));
+    EXPECT_TRUE(ECSIsEntityValid(entity));
+    EXPECT_TRUE(ECSIsEntityValid(entity2));
+    EXPECT_TRUE(ECSIsEntityValid(entity4));
+    EXPECT_EQ(ECS_GET_COMPONENT(entity, TestData)->updateCalled, 7);
+    Check2ListEquivalent(ECSGetEntitiesWithSystem(TEST_SYSTEM_NAME), {entity, entity2});
+
+    // the snapshot can be restored again
+    ECS_GET_COMPONENT(entity, TestData)->updateCalled = 50;
+    ECSRestore(snapshot);
+    EXPECT_EQ(ECS_GET_COMPONENT(entity, TestData)->updateCalled, 7);
+    EXPECT_EQ(ECS_GetAllEntitiesIn(GAME_LAYER).size(), 3);
+}
+
+TEST_F(ECSTest, RestoreSnapshotRemapsTheTakenIds)
+{
+    auto parent = ECSCreateEntity(
+        "Parent",
+        {ECS_CREATE_COMPONENT(Geometry)});
+    auto child = ECSCreateEntity(
+        "Child",
+        {ECS_CREATE_COMPONENT(Geometry), ECS_CREATE_COMPONENT(Parent, parent)});
+
+    auto snapshot = ECSSnapshot({GAME_LAYER});
+
+    // the slot of the parent is taken by an entity of another layer
+    ECSDeleteEntity(parent);
+    ECSBeginLayer(EDITOR_LAYER);
+    auto other = ECSCreateEntity(
+        "Other",
+        {ECS_CREATE_COMPONENT(TestData)});
+    ECSBeginLayer(GAME_LAYER);
+    EXPECT_EQ(EntityIndex(other), EntityIndex(parent));
+
+    auto restored = ECSRestore(snapshot);
+
+    EXPECT_TRUE(ECSIsEntityValid(other));
+    EXPECT_TRUE(ECSIsEntityValid(child));
+    EXPECT_FALSE(ECSIsEntityValid(parent));
+
+    auto restoredParent = ECS_GET_COMPONENT(child, Parent)->parentId;
+    EXPECT_NE(restoredParent, parent);
+    EXPECT_THAT(restored, ::testing::Contains(restoredParent));
+    EXPECT_EQ(ECSGetEntityByName("Parent"), restoredParent);
+}
+
+namespace
+{
+    Ref<WorldSnapshot> s_restoredSnapshot = nullptr;
+    entity_id_t s_deletedBeforeRestore = INVALID_ENTITY_ID;
+    entity_id_t s_createdBeforeRestore = INVALID_ENTITY_ID;
+}
+
+class TestRestoreSystem : public System
+{
+public:
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override
+    {
+        if (s_restoredSnapshot == nullptr)
+        {
+            return;
+        }
+
+        // the commands which are recorded before the restore are dropped
+        ECSDeleteEntity(s_deletedBeforeRestore);
+        s_createdBeforeRestore = ECSCreateEntity(
+            "CreatedBeforeRestore",
+            {ECS_CREATE_COMPONENT(TestData)});
+
+        ECSRestore(s_restoredSnapshot);
+        s_restoredSnapshot = nullptr;
+    }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+};
+
+TEST_F(ECSTest, RestoreSnapshotInsideUpdateKeepsTheEntityIds)
+{
+    ECSRegister("TestRestoreSystem", CreateRef<TestRestoreSystem>(), {typeid(NonTestData)});
+
+    auto restorer = ECSCreateEntity(
+        "Restorer",
+        {ECS_CREATE_COMPONENT(NonTestData)});
+
+    data->updateCalled = 7;
+    s_restoredSnapshot = ECSSnapshot({GAME_LAYER});
+    s_deletedBeforeRestore = entity;
+    data->updateCalled = 100;
+
+    ECSUpdate(0.0f);
+
+    EXPECT_FALSE(ECSIsEntityValid(s_createdBeforeRestore));
+    EXPECT_TRUE(ECSIsEntityValid(entity));
+    EXPECT_TRUE(ECSIsEntityValid(entity2));
+    EXPECT_TRUE(ECSIsEntityValid(entity4));
+    EXPECT_TRUE(ECSIsEntityValid(restorer));
+    EXPECT_EQ(ECS_GET_COMPONENT(entity, TestData)->updateCalled, 7);
+    EXPECT_EQ(ECS_GetAllEntitiesIn(GAME_LAYER).size(), 4);
+    Check2ListEquivalent(ECSGetEntitiesWithSystem(TEST_SYSTEM_NAME), {entity, entity2});
+    Check2ListEquivalent(ECSGetEntitiesWithSystem("TestRestoreSystem"), {entity4, restorer});
+}
+
+TEST_F(ECSTest, SystemStatsAreCollected)
+{
+    ECSUpdate(0.0f);
+
+    auto frame = ECSGetFrameStats();
+    EXPECT_EQ(frame.createdEntities, 3);
+    EXPECT_EQ(frame.entitiesCount, 3);
+
+    ECSUpdate(0.0f);
+
+    auto stats = ECSGetSystemStats();
+    auto it = std::find_if(stats.begin(), stats.end(),
+                           [](const SystemStats &stats)
+                           { return stats.name == TEST_SYSTEM_NAME; });
+    ASSERT_NE(it, stats.end());
+
+    EXPECT_TRUE(it->active);
+    EXPECT_EQ(it->entitiesCount, 2);
+    EXPECT_EQ(it->updatesCount, 2);
+    EXPECT_GE(it->maxTime, it->averageTime);
+    EXPECT_GE(it->totalTime, it->maxTime);
+    EXPECT_EQ(ECSGetFrameStats().createdEntities, 0);
+
+    ECSDeleteEntity(entity2);
+    ECSSetComponentActive(entity, typeid(TestData), FALSE);
+    ECSUpdate(0.0f);
+
+    frame = ECSGetFrameStats();
+    EXPECT_EQ(frame.deletedEntities, 1);
+    EXPECT_EQ(frame.componentStateChanges, 1);
+    EXPECT_EQ(frame.entitiesCount, 2);
+
+    ECSResetStats();
+
+    for (auto &system : ECSGetSystemStats())
+    {
+        EXPECT_EQ(system.updatesCount, 0);
+    }
+}
+
+TEST_F(ECSTest, ComponentsCanBeAddedAndRemoved)
+{
+    ECSUpdate(0.0f);
+
+    auto added = CreatePooledRef<TestData>();
+    ECSAddComponent(entity4, typeid(TestData), added);
+
+    // the other components are moved as is
+    EXPECT_EQ(ECS_GET_COMPONENT(entity4, NonTestData), data4);
+    EXPECT_EQ(ECS_GET_COMPONENT(entity4, TestData), added);
+    EXPECT_EQ(added->initCalled, 1);
+    EXPECT_EQ(added->entity_id, entity4);
+    EXPECT_THAT(ECSGetEntitiesWithSystem(TEST_SYSTEM_NAME),
+                ::testing::UnorderedElementsAre(entity, entity2, entity4));
+
+    ECSUpdate(0.0f);
+    EXPECT_EQ(added->updateCalled, 1);
+
+    // the entity which is moved into the removed row keeps its components
+    ECSRemoveComponent(entity, typeid(TestData));
+
+    EXPECT_EQ(data->shutdownCalled, 1);
+    EXPECT_EQ(ECS_GET_COMPONENT(entity, TestData), nullptr);
+    EXPECT_TRUE(ECSIsEntityValid(entity));
+    EXPECT_EQ(ECS_GET_COMPONENT(entity2, TestData), data2);
+    EXPECT_THAT(ECSGetEntitiesWithSystem(TEST_SYSTEM_NAME),
+                ::testing::UnorderedElementsAre(entity2, entity4));
+
+    // inside a query the changes are applied after the iteration
+    ECSForEach<NonTestData>(
+        [](entity_id_t id, NonTestData &)
+        {
+            ECS_REMOVE_COMPONENT(id, TestData);
+            EXPECT_NE(ECS_GET_COMPONENT(id, TestData), nullptr);
+        });
+
+    EXPECT_EQ(ECS_GET_COMPONENT(entity4, TestData), nullptr);
+    EXPECT_EQ(added->shutdownCalled, 1);
+
+    // both removals are made after the previous frame
+    ECSUpdate(0.0f);
+    EXPECT_EQ(ECSGetFrameStats().componentStructureChanges, 2);
+}
+
+class TestMoveSystem : public System
+{
+public:
+    List<f32> deltas;
+
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override
+    {
+        deltas.push_back(delta);
+        ECS_GET_COMPONENT(id, Geometry)->pos.x += delta;
+    }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+};
+
+class TestOrderSystem : public System
+{
+public:
+    TestOrderSystem(List<String> &order, const String &name)
+        : m_order(order), m_name(name)
+    {
+    }
+
+    void InitSystem() override {}
+    void InitEntity(entity_id_t id) override {}
+    void Update(f32 delta, entity_id_t id) override { m_order.push_back(m_name); }
+    void ShutdownEntity(entity_id_t id) override {}
+    void ShutdownSystem() override {}
+
+private:
+    List<String> &m_order;
+    String m_name;
+};
+
+TEST_F(ECSTest, FixedStepsKeepTheRegistrationOrder)
+{
+    List<String> order = {};
+    ECSRegister("Before", CreateRef<TestOrderSystem>(order, "Before"), {typeid(NonTestData)});
+    ECSRegister("Fixed", CreateRef<TestOrderSystem>(order, "Fixed"),
+                {typeid(NonTestData)}, FALSE, SystemAccess(), TRUE);
+    ECSRegister("After", CreateRef<TestOrderSystem>(order, "After"), {typeid(NonTestData)});
+    ECSSetFixedStep(10.0f);
+    ECSCreateEntity("Ordered", {ECS_CREATE_COMPONENT(NonTestData)});
+
+    ECSUpdate(20.0f);
+
+    EXPECT_EQ(order, List<String>({"Before", "Fixed", "Fixed", "After"}));
+}
+
+TEST_F(ECSTest, FixedSystemsRunAtConstantRate)
+{
+    auto moveSystem = CreateRef<TestMoveSystem>();
+    ECSRegister("TestMoveSystem", moveSystem, {typeid(Geometry)}, FALSE, SystemAccess(), TRUE);
+    ECSSetFixedStep(10.0f, 3);
+
+    auto moved = ECSCreateEntity("Moved", {ECS_CREATE_COMPONENT(Geometry, 0.0f, 0.0f)});
+    auto geo = ECS_GET_COMPONENT(moved, Geometry);
+
+    ECSUpdate(25.0f);
+
+    EXPECT_THAT(moveSystem->deltas, ::testing::ElementsAre(10.0f, 10.0f));
+    EXPECT_EQ(ECSGetFrameStats().fixedSteps, 2);
+    EXPECT_EQ(data->updateCalled, 1);
+
+    // the drawn position is between the last two steps
+    EXPECT_FLOAT_EQ(geo->pos.x, 20.0f);
+    EXPECT_FLOAT_EQ(ECSGetFixedStepAlpha(), 0.5f);
+    EXPECT_FLOAT_EQ(geo->GetDrawnPos().x, 15.0f);
+
+    // the slow frame is capped, the remaining time is dropped
+    moveSystem->deltas.clear();
+    ECSUpdate(100.0f);
+
+    EXPECT_EQ(moveSystem->deltas.size(), 3);
+    EXPECT_EQ(data->updateCalled, 2);
+    EXPECT_FLOAT_EQ(geo->pos.x, 50.0f);
+    EXPECT_FLOAT_EQ(ECSGetFixedStepAlpha(), 0.5f);
+
+    // no complete step, the fixed systems are not updated
+    moveSystem->deltas.clear();
+    ECSUpdate(4.0f);
+
+    EXPECT_TRUE(moveSystem->deltas.empty());
+    EXPECT_FLOAT_EQ(geo->GetDrawnPos().x, 49.0f);
+
+    // without the fixed step, the systems use the frame delta
+    ECSSetFixedStep(0.0f);
+    ECSUpdate(4.0f);
+
+    EXPECT_THAT(moveSystem->deltas, ::testing::ElementsAre(4.0f));
+    EXPECT_FLOAT_EQ(geo->GetDrawnPos().x, 54.0f);
+}
@@ -1,6 +1,7 @@
 #include <NTTEngine/ecs/ecs.hpp>
 #include <NTTEngine/core/logging/logging.hpp>
 #include <NTTEngine/structures/dictionary.hpp>
+#include <NTTEngine/structures/sparse_set.hpp>
 #include <NTTEngine/dev/store.hpp>
 #include <NTTEngine/application/event_system/event_system.hpp>
 #include <NTTEngine/ecs/data_com.hpp>
@@ -9,45 +10,416 @@
 #include <NTTEngine/renderer/Geometry.hpp>
 #include <NTTEngine/core/object.hpp>
 #include <cstring>
+#include <mutex>
+#include <deque>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <NTTEngine/core/auto_naming.hpp>
+#include <NTTEngine/core/thread_pool.hpp>
+#include <NTTEngine/ecs/prefab.hpp>
 
 namespace ntt
 {
     using component_id_t = entity_id_t;
 #define INVALID_UI_LAYER 255
+#define MIN_CHUNK_SIZE 256 ///< The splittable systems are only split into chunks
+                           ///<    which have at least this number of entities
 
     struct SystemInfo : public Object
     {
         String name;
         Ref<System> system;
         List<std::type_index> componentTypes;
-        List<entity_id_t> entities;
+        SparseSet<entity_id_t, EntityIndexOf> entities;
         b8 alwayUpdate = FALSE;
         b8 active = TRUE;
+        SystemAccess access;
+        b8 fixedStep = FALSE;    ///< Updated with the constant delta of the fixed step
+        b8 beforeFixed = FALSE;  ///< Registered before the first fixed system (see BuildStages)
+        List<entity_id_t> batch; ///< The entities which are updated in the current frame
+        u32 runTick = 0;         ///< The change tick of the current update
+        u32 lastRunTick = 0;     ///< The change tick of the previous update
+
+        // the timings of the last updates (see ECSGetSystemStats)
+        std::atomic<i64> frameMicroseconds{0}; ///< The chunks can be updated at the same time
+        f32 times[ECS_STATS_WINDOW] = {};
+        u32 timesNext = 0;
+        u32 timesCount = 0;
+        u32 lastEntitiesCount = 0;
 
         SystemInfo(String name,
                    Ref<System> system,
                    List<std::type_index> componentTypes,
-                   b8 alwayUpdate = FALSE)
+                   b8 alwayUpdate = FALSE,
+                   const SystemAccess &access = SystemAccess(),
+                   b8 fixedStep = FALSE)
             : name(name), system(system),
               componentTypes(componentTypes),
               alwayUpdate(alwayUpdate),
-              active(TRUE)
+              active(TRUE),
+              access(access),
+              fixedStep(fixedStep)
         {
         }
     };
 
     using system_id_t = u32;
+    using archetype_id_t = u32;
+
+    /**
+     * Group of all entities which have the exact same set of components. Each
+     *      component type has its own column, and all columns are aligned by
+     *      row, so the components of the same entity are stored at the same
+     *      row in every column. Iterating over a set of component types is
+     *      then a linear walk over the columns of the matched archetypes.
+     *
+     * The columns store the references of the components, not the values:
+     *      the components are still allocated one by one since the API
+     *      (ECSGetEntityComponent, the snapshots, the held Ref of the systems)
+     *      shares them and they must outlive the row moves. The map lookup
+     *      per access is gone, but the packed value columns (even for the
+     *      POD types like Geometry and Mass) are not a part of this storage.
+     */
+    struct Archetype : public Object
+    {
+        List<std::type_index> types;            ///< The sorted component types (signature)
+        List<List<Ref<ComponentBase>>> columns; ///< One column of references per type
+        List<entity_id_t> entities;             ///< The owner entity of each row
+        List<system_id_t> systems;              ///< The systems whose types are all
+                                                ///<    contained in the signature
+        List<i32> typeIdColumns;                ///< The column of each component type id
+                                                ///<    (see ComponentTypeId), -1 if missing
+        List<List<u32>> changedTicks;           ///< The tick of the last change of each component,
+                                                ///<    aligned with the columns
+        List<List<u32>> addedTicks;             ///< The tick when each component was added
+
+        Archetype(const List<std::type_index> &types)
+            : types(types), columns(), entities(), systems(), typeIdColumns(),
+              changedTicks(), addedTicks()
+        {
+            columns.resize(types.size());
+            changedTicks.resize(types.size());
+            addedTicks.resize(types.size());
+
+            for (u32 i = 0; i < types.size(); i++)
+            {
+                auto typeId = ECSGetComponentTypeId(types[i]);
+
+                if (typeId >= typeIdColumns.size())
+                {
+                    typeIdColumns.resize(typeId + 1, -1);
+                }
+
+                typeIdColumns[typeId] = i;
+            }
+        }
+
+        /**
+         * Retrieve the column index of the component type, if the type is not
+         *      a part of the signature, then return -1
+         */
+        i32 ColumnOf(std::type_index type) const
+        {
+            for (u32 i = 0; i < types.size(); i++)
+            {
+                if (types[i] == type)
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+    };
+
+    /**
+     * The internal information of an entity, the components are not stored here
+     *      but in the columns of the archetype at the given row.
+     */
+    struct EntityRecord : public Object
+    {
+        String name;
+        archetype_id_t archetype;
+        u32 row;
+        b8 deleting = FALSE; ///< Avoid deleting twice when a system deletes the entity
+                             ///<    inside its ShutdownEntity callback
+        b8 deleted = FALSE;  ///< The delete command is recorded but not applied yet
+        b8 attached = FALSE; ///< The entity is added to its systems (see AttachEntities)
+
+        EntityRecord(const String &name, archetype_id_t archetype, u32 row)
+            : name(name), archetype(archetype), row(row), deleting(FALSE), deleted(FALSE),
+              attached(FALSE)
+        {
+        }
+    };
+
+    /**
+     * Stores the records of all entities with the generational IDs (see the
+     *      EntityIndex and EntityGeneration). The freed slots are reused in
+     *      the FIFO order so a slot rests as long as possible before its
+     *      generation is increased again. Adding, querying and releasing
+     *      are all O(1), the entities are indexed by their names as well.
+     */
+    class EntityStore
+    {
+    public:
+        EntityStore() : m_slots(), m_freeSlots(), m_count(0), m_names() {}
+
+        /**
+         * Store the record and return the ID of the new entity, if there are
+         *      too many entities, then return INVALID_ENTITY_ID
+         */
+        entity_id_t Add(Ref<EntityRecord> record)
+        {
+            u32 index = INVALID_ENTITY_ID;
+
+            // the slots which are taken by AddAt are still in the free list
+            while (!m_freeSlots.empty())
+            {
+                u32 freeIndex = m_freeSlots.front();
+                m_freeSlots.pop_front();
+
+                if (m_slots[freeIndex].record == nullptr)
+                {
+                    index = freeIndex;
+                    break;
+                }
+            }
+
+            if (index == INVALID_ENTITY_ID)
+            {
+                // the reserved slots are only taken by their own AddAt
+                while (m_slots.size() < m_reservedEnd)
+                {
+                    m_slots.push_back(Slot());
+                }
+
+                if (m_slots.size() >= MAX_ENTITIES)
+                {
+                    NTT_ENGINE_WARN("The maximum number of entities is reached");
+                    return INVALID_ENTITY_ID;
+                }
+
+                index = m_slots.size();
+                m_slots.push_back(Slot());
+            }
+
+            m_slots[index].record = record;
+            m_count++;
+
+            entity_id_t id = MakeEntityId(index, m_slots[index].generation);
+            m_names[record->name].push_back(id);
+
+            return id;
+        }
+
+        /**
+         * Retrieve the record of the entity, if the ID is not valid (or the
+         *      entity of the ID is already deleted), then return nullptr
+         */
+        Ref<EntityRecord> Get(entity_id_t id) const
+        {
+            u32 index = EntityIndex(id);
+
+            if (index >= m_slots.size())
+            {
+                return nullptr;
+            }
+
+            auto &slot = m_slots[index];
+
+            if (slot.generation != EntityGeneration(id))
+            {
+                return nullptr;
+            }
+
+            return slot.record;
+        }
+
+        /**
+         * Store the record with the exact given ID (used when the entities
+         *      are restored from a snapshot), if the slot of the ID is already
+         *      used by another entity, then return INVALID_ENTITY_ID
+         */
+        entity_id_t AddAt(entity_id_t id, Ref<EntityRecord> record)
+        {
+            u32 index = EntityIndex(id);
+
+            if (id == INVALID_ENTITY_ID || index >= MAX_ENTITIES)
+            {
+                return INVALID_ENTITY_ID;
+            }
+
+            while (m_slots.size() <= index)
+            {
+                if (m_slots.size() < index && m_slots.size() >= m_reservedEnd)
+                {
+                    m_freeSlots.push_back(m_slots.size());
+                }
+
+                m_slots.push_back(Slot());
+            }
+
+            auto &slot = m_slots[index];
+
+            if (slot.record != nullptr)
+            {
+                return INVALID_ENTITY_ID;
+            }
+
+            slot.record = record;
+            slot.generation = EntityGeneration(id);
+            m_count++;
+
+            m_names[record->name].push_back(id);
+
+            return id;
+        }
+
+        b8 Contains(entity_id_t id) const
+        {
+            return Get(id) != nullptr;
+        }
+
+        /**
+         * Reserve the ID of a new slot without touching the stored slots, so
+         *      it's safe while the other threads are reading the store. The
+         *      entity is stored later with AddAt, if there are too many
+         *      entities, then return INVALID_ENTITY_ID
+         */
+        entity_id_t Reserve()
+        {
+            std::lock_guard<std::mutex> lock(m_reserveMutex);
+
+            u32 index = std::max(static_cast<u32>(m_slots.size()), m_reservedEnd);
+
+            if (index >= MAX_ENTITIES)
+            {
+                NTT_ENGINE_WARN("The maximum number of entities is reached");
+                return INVALID_ENTITY_ID;
+            }
+
+            m_reservedEnd = index + 1;
+            return MakeEntityId(index, 0);
+        }
+
+        void Release(entity_id_t id)
+        {
+            if (!Contains(id))
+            {
+                return;
+            }
+
+            u32 index = EntityIndex(id);
+            auto &slot = m_slots[index];
+
+            auto name = m_names.find(slot.record->name);
+            name->second.RemoveItem(id);
+
+            if (name->second.empty())
+            {
+                m_names.erase(name);
+            }
+
+            slot.record = nullptr;
+            slot.generation = (slot.generation + 1) & ENTITY_GENERATION_MASK;
+
+            // the generation which makes the INVALID_ENTITY_ID is skipped
+            if (MakeEntityId(index, slot.generation) == INVALID_ENTITY_ID)
+            {
+                slot.generation = 0;
+            }
+
+            m_freeSlots.push_back(index);
+            m_count--;
+        }
+
+        u32 Count() const { return m_count; }
+
+        /**
+         * The IDs of the entities which have the given name
+         */
+        const List<entity_id_t> &GetIdsByName(const String &name) const
+        {
+            static const List<entity_id_t> empty = {};
+
+            auto it = m_names.find(name);
+            return it == m_names.end() ? empty : it->second;
+        }
+
+        List<entity_id_t> GetAvailableIds() const
+        {
+            List<entity_id_t> ids;
+
+            for (u32 i = 0; i < m_slots.size(); i++)
+            {
+                if (m_slots[i].record != nullptr)
+                {
+                    ids.push_back(MakeEntityId(i, m_slots[i].generation));
+                }
+            }
+
+            return ids;
+        }
+
+    private:
+        struct Slot
+        {
+            Ref<EntityRecord> record = nullptr;
+            u32 generation = 0;
+        };
+
+        List<Slot> m_slots;
+        std::deque<u32> m_freeSlots;
+        u32 m_count;
+        std::unordered_map<String, List<entity_id_t>> m_names;
+        u32 m_reservedEnd = 0; ///< The slots from the stored ones to this index are reserved
+        std::mutex m_reserveMutex;
+    };
+
+    enum EntityCommandType
+    {
+        ENTITY_COMMAND_CREATE,
+        ENTITY_COMMAND_DELETE,
+        ENTITY_COMMAND_SET_COMPONENT_ACTIVE,
+        ENTITY_COMMAND_ADD_COMPONENT,
+        ENTITY_COMMAND_REMOVE_COMPONENT,
+    };
+
+    /**
+     * The structural change which is requested while the systems are updated,
+     *      all recorded commands are applied in order at the end of ECSUpdate.
+     */
+    struct EntityCommand
+    {
+        EntityCommandType type;
+        entity_id_t id;
+        layer_t layer = GAME_LAYER;                   ///< Only used with ENTITY_COMMAND_CREATE
+        std::type_index componentType = typeid(void); ///< Used with the component commands
+        b8 active = TRUE;                             ///< Only used with ENTITY_COMMAND_SET_COMPONENT_ACTIVE
+        Ref<ComponentBase> component = nullptr;       ///< Only used with ENTITY_COMMAND_ADD_COMPONENT
+
+        // the entity which is created by a parallel system only has a reserved
+        //      ID, it's inserted into the storage when the command is applied
+        b8 inserting = FALSE;
+        String name;
+        Dictionary<std::type_index, Ref<ComponentBase>> components;
+    };
 
     namespace
     {
         Scope<Store<system_id_t, SystemInfo>> s_systemsStore;
-        Scope<Store<entity_id_t, EntityInfo>> s_entityStore;
+        Scope<EntityStore> s_entityStore;
 
-        List<entity_id_t> s_DrawnEntities;
-        List<entity_id_t> s_UpdatedEntities;
+        List<Ref<Archetype>> s_archetypes;
+        Dictionary<List<std::type_index>, archetype_id_t> s_archetypeIds;
 
-        Scope<List<entity_id_t>> layers[MAX_LAYERS];
+        SparseSet<entity_id_t, EntityIndexOf> s_DrawnEntities;
+        SparseSet<entity_id_t, EntityIndexOf> s_UpdatedEntities;
+
+        Scope<SparseSet<entity_id_t, EntityIndexOf>> layers[MAX_LAYERS];
         List<b8> layersVisibility;
         layer_t currentLayer = GAME_LAYER;
         layer_t currentRunningLayer = GAME_LAYER;
@@ -78,87 +450,377 @@ namespace ntt
             s_DrawnEntities.clear();
             s_UpdatedEntities.clear();
 
-            s_DrawnEntities.insert(
-                s_DrawnEntities.end(),
-                layers[GAME_LAYER]->begin(),
-                layers[GAME_LAYER]->end());
+            for (auto entity : *(layers[GAME_LAYER]))
+            {
+                s_DrawnEntities.Add(entity);
+            }
 
             if (uiLayerVisible != INVALID_UI_LAYER)
             {
-                s_DrawnEntities.insert(
-                    s_DrawnEntities.end(),
-                    layers[uiLayerVisible]->begin(),
-                    layers[uiLayerVisible]->end());
+                for (auto entity : *(layers[uiLayerVisible]))
+                {
+                    s_DrawnEntities.Add(entity);
+                }
             }
 
             if (currentRunningLayer == EDITOR_LAYER)
             {
-                s_DrawnEntities.insert(
-                    s_DrawnEntities.end(),
-                    layers[EDITOR_LAYER]->begin(),
-                    layers[EDITOR_LAYER]->end());
+                for (auto entity : *(layers[EDITOR_LAYER]))
+                {
+                    s_DrawnEntities.Add(entity);
+                }
             }
 
             for (auto entity : *(layers[currentRunningLayer]))
             {
-                s_UpdatedEntities.push_back(entity);
+                s_UpdatedEntities.Add(entity);
+            }
+        }
+
+        /**
+         * While it's positive (inside ECSUpdate or a query), the structural
+         *      changes are recorded and applied when it's back to 0
+         */
+        std::atomic<u32> s_deferDepth(0);
+        List<EntityCommand> s_commands;
+        std::mutex s_commandsMutex;
+
+        /**
+         * While it's positive, the chunks of a query are visited and no row
+         *      can be removed or moved, so the layers which are cleared
+         *      meanwhile are kept here and cleared right after the visit
+         */
+        std::atomic<u32> s_chunkVisitDepth(0);
+        List<layer_t> s_pendingClearLayers;
+
+        // the structural changes of the current frame (see ECSGetFrameStats)
+        std::atomic<u32> s_createdEntities = 0;
+        std::atomic<u32> s_deletedEntities = 0;
+        std::atomic<u32> s_componentStateChanges = 0;
+        std::atomic<u32> s_componentStructureChanges = 0;
+        ECSFrameStats s_frameStats = {};
+
+        Dictionary<std::type_index, component_type_id_t> s_componentTypeIds;
+        std::mutex s_componentTypeIdsMutex;
+
+        b8 IsDeferring()
+        {
+            return s_deferDepth > 0;
+        }
+
+        b8 IsLayerDrawn(layer_t layer)
+        {
+            return layer == GAME_LAYER ||
+                   layer == uiLayerVisible ||
+                   (layer == EDITOR_LAYER && currentRunningLayer == EDITOR_LAYER);
+        }
+
+        /**
+         * Add the new entity to the drawn/updated entities without rebuilding
+         *      them from all the layers (the rebuild is only needed when the
+         *      visible layers are changed)
+         */
+        void AddEntityState(entity_id_t id, layer_t layer)
+        {
+            if (IsLayerDrawn(layer))
+            {
+                s_DrawnEntities.Add(id);
+            }
+
+            if (layer == currentRunningLayer)
+            {
+                s_UpdatedEntities.Add(id);
+            }
+        }
+
+        void RecordCommand(const EntityCommand &command)
+        {
+            std::lock_guard<std::mutex> lock(s_commandsMutex);
+            s_commands.push_back(command);
+        }
+
+        /**
+         * The systems which are updated at the same time, each stage only
+         *      starts after all systems of the previous stage are finished
+         */
+        List<List<system_id_t>> s_stages;
+        b8 s_stagesDirty = TRUE;
+
+        /**
+         * The change tick is increased for each system update (and once more
+         *      after ECSUpdate), the components store the tick of their last
+         *      change so a system only needs to compare it with its last tick.
+         */
+        u32 s_changeTick = 1;
+        thread_local u32 t_sinceTick = 0; ///< The last tick of the running system, 0 outside
+        thread_local u32 t_writeTick = 0; ///< The tick of the running system, 0 outside
+
+        /**
+         * The running system can be updated at the same time with the others,
+         *      so the storage must not be changed (the new entities are only
+         *      reserved, see ReserveEntity)
+         */
+        thread_local b8 t_parallelUpdate = FALSE;
+
+        /**
+         * The declared access of the running system, nullptr outside the
+         *      system updates or for the undeclared systems
+         */
+        thread_local const SystemAccess *t_runningAccess = nullptr;
+
+        /**
+         * The running system only declared the type as a read, so the fetched
+         *      component is not marked as changed (the systems of the same
+         *      stage may read or mark the same ticks on the other threads)
+         */
+        b8 IsDeclaredRead(std::type_index type)
+        {
+            return t_runningAccess != nullptr &&
+                   t_runningAccess->reads.Contains(type) &&
+                   !t_runningAccess->writes.Contains(type);
+        }
+
+        f32 s_fixedStepTime = 0.0f; ///< 0 if the fixed step is disabled
+        u32 s_maxFixedSteps = ECS_MAX_FIXED_STEPS;
+        f32 s_fixedStepAccumulator = 0.0f; ///< The frame time which is not simulated yet
+        u32 s_fixedStepIndex = 0;
+
+        enum UpdatePass
+        {
+            UPDATE_PASS_ALL,          ///< All systems (the fixed step is disabled)
+            UPDATE_PASS_BEFORE_FIXED, ///< The frame delta systems registered before the first fixed one
+            UPDATE_PASS_FIXED,        ///< Only the fixed systems
+            UPDATE_PASS_AFTER_FIXED,  ///< The remaining frame delta systems
+        };
+
+        u32 CurrentWriteTick()
+        {
+            return t_writeTick != 0 ? t_writeTick : s_changeTick;
+        }
+
+        b8 IsSignatureMatched(const List<std::type_index> &signature,
+                              const List<std::type_index> &systemTypes)
+        {
+            for (auto type : systemTypes)
+            {
+                if (!signature.Contains(type))
+                {
+                    return FALSE;
+                }
+            }
+
+            return TRUE;
+        }
+
+        /**
+         * Retrieve the archetype of the given sorted signature, the archetype
+         *      will be created (and matched with all registered systems)
+         *      if it does not exist yet.
+         */
+        archetype_id_t GetArchetype(const List<std::type_index> &signature)
+        {
+            PROFILE_FUNCTION();
+
+            auto it = s_archetypeIds.find(signature);
+            if (it != s_archetypeIds.end())
+            {
+                return it->second;
             }
+
+            archetype_id_t archetypeId = s_archetypes.size();
+            auto archetype = CreateRef<Archetype>(signature);
+
+            s_systemsStore->ForEach(
+                [&archetype](Ref<SystemInfo> system, const system_id_t systemId)
+                {
+                    if (IsSignatureMatched(archetype->types, system->componentTypes))
+                    {
+                        archetype->systems.push_back(systemId);
+                    }
+                });
+
+            s_archetypes.push_back(archetype);
+            s_archetypeIds[signature] = archetypeId;
+
+            return archetypeId;
         }
 
-        List<entity_id_t> s_deletedEntities;
+        /**
+         * Remove the row from the archetype by moving the last row into its
+         *      place, the record of the moved entity is updated accordingly.
+         */
+        void ArchetypeRemoveRow(archetype_id_t archetypeId, u32 row)
+        {
+            PROFILE_FUNCTION();
+
+            auto archetype = s_archetypes[archetypeId];
+            u32 lastRow = archetype->entities.size() - 1;
+
+            if (row != lastRow)
+            {
+                for (u32 i = 0; i < archetype->columns.size(); i++)
+                {
+                    archetype->columns[i][row] = archetype->columns[i][lastRow];
+                    archetype->changedTicks[i][row] = archetype->changedTicks[i][lastRow];
+                    archetype->addedTicks[i][row] = archetype->addedTicks[i][lastRow];
+                }
+
+                archetype->entities[row] = archetype->entities[lastRow];
+                s_entityStore->Get(archetype->entities[row])->row = row;
+            }
+
+            for (u32 i = 0; i < archetype->columns.size(); i++)
+            {
+                archetype->columns[i].pop_back();
+                archetype->changedTicks[i].pop_back();
+                archetype->addedTicks[i].pop_back();
+            }
+
+            archetype->entities.pop_back();
+        }
 
         b8 IsEntityInSystem(system_id_t system_id, entity_id_t entity_id)
         {
             PROFILE_FUNCTION();
-            auto system = s_systemsStore->Get(system_id);
-            auto entities = system->entities;
-            auto systemTypes = system->componentTypes;
+            auto record = s_entityStore->Get(entity_id);
+            return s_archetypes[record->archetype]->systems.Contains(system_id);
+        }
 
-            auto components = s_entityStore->Get(entity_id)->components;
+        b8 IsSystemsConflicted(const SystemAccess &a, const SystemAccess &b)
+        {
+            if (!a.IsDeclared() || !b.IsDeclared())
+            {
+                return TRUE;
+            }
 
-            b8 isValid = TRUE;
-            for (auto j = 0; j < systemTypes.size(); j++)
+            for (auto type : a.writes)
             {
-                auto type = systemTypes[j];
+                if (b.reads.Contains(type) || b.writes.Contains(type))
+                {
+                    return TRUE;
+                }
+            }
 
-                if (!components.Contains(type))
+            for (auto type : b.writes)
+            {
+                if (a.reads.Contains(type))
                 {
-                    return FALSE;
+                    return TRUE;
+                }
+            }
+
+            return FALSE;
+        }
+
+        /**
+         * Group the systems into stages, each system is placed in the stage
+         *      right after the latest stage of the earlier registered systems
+         *      which it conflicts with, so the registration order is kept
+         *      for all conflicted systems. The fixed steps are run at the
+         *      place of the first fixed system, so the systems which are
+         *      registered before it are updated before the fixed steps.
+         */
+        void BuildStages()
+        {
+            PROFILE_FUNCTION();
+
+            s_stages.clear();
+
+            auto systemIds = s_systemsStore->GetAvailableIds();
+            List<u32> systemStages;
+            b8 beforeFixed = TRUE;
+
+            for (u32 i = 0; i < systemIds.size(); i++)
+            {
+                auto system = s_systemsStore->Get(systemIds[i]);
+                u32 stage = 0;
+
+                beforeFixed = beforeFixed && !system->fixedStep;
+                system->beforeFixed = beforeFixed;
+
+                for (u32 j = 0; j < i; j++)
+                {
+                    auto previous = s_systemsStore->Get(systemIds[j]);
+
+                    if (IsSystemsConflicted(system->access, previous->access))
+                    {
+                        stage = std::max(stage, systemStages[j] + 1);
+                    }
                 }
+
+                systemStages.push_back(stage);
+
+                if (stage >= s_stages.size())
+                {
+                    s_stages.resize(stage + 1);
+                }
+
+                s_stages[stage].push_back(systemIds[i]);
+            }
+
+            s_stagesDirty = FALSE;
+        }
+
+        void UpdateSystemBatch(Ref<SystemInfo> system, f32 delta, Span<const entity_id_t> ids)
+        {
+            u32 preSinceTick = t_sinceTick;
+            u32 preWriteTick = t_writeTick;
+            const SystemAccess *preAccess = t_runningAccess;
+            t_sinceTick = system->lastRunTick;
+            t_writeTick = system->runTick;
+            t_runningAccess = system->access.IsDeclared() ? &system->access : nullptr;
+
+            auto start = std::chrono::steady_clock::now();
+
+            try
+            {
+                system->system->UpdateBatch(delta, ids);
+            }
+            catch (const std::exception &e)
+            {
+                NTT_ENGINE_ERROR("Error in system: {} - System: {}", e.what(), system->name);
             }
 
-            return isValid;
+            system->frameMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(
+                                             std::chrono::steady_clock::now() - start)
+                                             .count();
+
+            t_sinceTick = preSinceTick;
+            t_writeTick = preWriteTick;
+            t_runningAccess = preAccess;
         }
 
         void InternalEntityDelete(entity_id_t id)
         {
             PROFILE_FUNCTION();
 
-            if (!s_entityStore->Contains(id))
+            auto record = s_entityStore->Get(id);
+
+            if (record == nullptr)
             {
                 // NTT_ENGINE_WARN("The entity with ID {} is not existed", id);
                 return;
             }
 
-            auto entityInfo = s_entityStore->Get(id);
-            NTT_ENGINE_TRACE("Deleting entity: {}", id);
+            if (record->deleting)
+            {
+                return;
+            }
 
-            auto keyComponents = entityInfo->components.Keys();
+            record->deleting = TRUE;
+            s_deletedEntities++;
+            NTT_ENGINE_TRACE("Deleting entity: {}", id);
 
-            auto availabeSystems = s_systemsStore->GetAvailableIds();
+            auto archetype = s_archetypes[record->archetype];
 
-            for (auto entityCom : entityInfo->components.Keys())
+            for (auto entityCom : archetype->types)
             {
                 ECSSetComponentActive(id, entityCom, TRUE);
             }
 
-            for (auto systemId : availabeSystems)
+            // only the systems which match the archetype can contain the entity
+            for (auto systemId : archetype->systems)
             {
-                // if (!IsEntityInSystem(systemId, id))
-                // {
-                //     continue;
-                // }
-
                 auto system = s_systemsStore->Get(systemId);
                 if (system->entities.Contains(id))
                 {
@@ -167,11 +829,7 @@ namespace ntt
                 }
             }
 
-            for (auto component : entityInfo->components)
-            {
-                component.second.reset();
-            }
-
+            ArchetypeRemoveRow(record->archetype, record->row);
             s_entityStore->Release(id);
 
             for (auto &layer : layers)
@@ -184,7 +842,8 @@ namespace ntt
                 layer->RemoveItem(id);
             }
 
-            ResetEntitiesState();
+            s_DrawnEntities.RemoveItem(id);
+            s_UpdatedEntities.RemoveItem(id);
 
             EventContext context;
             // must be changed when the entity_id_t is changed
@@ -192,420 +851,1923 @@ namespace ntt
             TriggerEvent(NTT_ENTITY_DESTROYED, nullptr, context);
         }
 
-    } // namespace
+        /**
+         * Add the created entities to the matched systems and the layer, the
+         *      entities are only visible to the systems after this function.
+         *      All entities are added to their systems before any InitEntity
+         *      is called, so the systems can look up the other entities of
+         *      the same batch (ex: the parent entity).
+         */
+        void AttachEntities(Span<const entity_id_t> ids, layer_t layer)
+        {
+            PROFILE_FUNCTION();
 
-    void ECSInit()
-    {
-        PROFILE_FUNCTION();
+            for (auto id : ids)
+            {
+                auto record = s_entityStore->Get(id);
+                auto archetype = s_archetypes[record->archetype];
+
+                for (auto systemId : archetype->systems)
+                {
+                    s_systemsStore->Get(systemId)->entities.Add(id);
+                }
+
+                record->attached = TRUE;
+
+                // the deferred entities are only visible to the systems from now
+                u32 tick = CurrentWriteTick();
+                for (u32 i = 0; i < archetype->columns.size(); i++)
+                {
+                    archetype->addedTicks[i][record->row] = tick;
+                    archetype->changedTicks[i][record->row] = tick;
+                }
+            }
+
+            // the entity must be added to all the systems which need the components
+            //     before the init function is called
+            for (auto id : ids)
+            {
+                auto record = s_entityStore->Get(id);
+
+                // the entity can be deleted by the init function of the others
+                if (record == nullptr)
+                {
+                    continue;
+                }
+
+                auto archetype = s_archetypes[record->archetype];
+
+                for (auto systemId : archetype->systems)
+                {
+                    s_systemsStore->Get(systemId)->system->InitEntity(id);
+                }
+            }
+
+            if (layer >= MAX_LAYERS)
+            {
+                return;
+            }
+
+            for (auto id : ids)
+            {
+                auto record = s_entityStore->Get(id);
+
+                if (record == nullptr)
+                {
+                    continue;
+                }
+
+                layers[layer]->Add(id);
+                AddEntityState(id, layer);
+
+                NTT_ENGINE_TRACE("Entit {} has id {}", record->name, id);
+                EventContext context;
+                // must be changed when the entity_id_t is changed
+                context.u32_data[0] = id;
+                TriggerEvent(NTT_ENTITY_CREATED, nullptr, context);
+            }
+        }
+
+        /**
+         * Attach the inserted entities immediately, or record their create
+         *      commands while the structural changes are deferred
+         */
+        void AttachOrRecordEntities(Span<const entity_id_t> ids, layer_t layer)
+        {
+            if (!IsDeferring())
+            {
+                AttachEntities(ids, layer);
+                return;
+            }
+
+            for (auto id : ids)
+            {
+                EntityCommand command;
+                command.type = ENTITY_COMMAND_CREATE;
+                command.id = id;
+                command.layer = layer;
+                RecordCommand(command);
+            }
+        }
+
+        void AttachEntity(entity_id_t id, layer_t layer)
+        {
+            AttachEntities(Span<const entity_id_t>(&id, 1), layer);
+        }
+
+        /**
+         * The sorted signature of the entity with the given components, the
+         *      DataComponent is always a part of the signature.
+         */
+        List<std::type_index> SignatureOf(
+            const Dictionary<std::type_index, Ref<ComponentBase>> &components)
+        {
+            // the dictionary is ordered by the type, so the keys are already sorted
+            List<std::type_index> signature = components.Keys();
+
+            if (!components.Contains(typeid(DataComponent)))
+            {
+                signature.insert(
+                    std::lower_bound(signature.begin(), signature.end(),
+                                     std::type_index(typeid(DataComponent))),
+                    typeid(DataComponent));
+            }
+
+            return signature;
+        }
+
+        /**
+         * Store the record and the components of the new entity in the
+         *      archetype, the entity is not added to any system yet. A new
+         *      DataComponent is always created for the entity.
+         *
+         * The restored entities (from a snapshot) keep the given
+         *      DataComponent and the layer priority as is. If the `id` is
+         *      given, the entity is stored with that exact ID, and
+         *      INVALID_ENTITY_ID is returned when the slot is already taken.
+         */
+        entity_id_t InsertEntity(
+            const String &name,
+            archetype_id_t archetypeId,
+            const Dictionary<std::type_index, Ref<ComponentBase>> &components,
+            b8 restoring = FALSE,
+            entity_id_t id = INVALID_ENTITY_ID)
+        {
+            auto archetype = s_archetypes[archetypeId];
+            auto record = CreatePooledRef<EntityRecord>(name, archetypeId, archetype->entities.size());
+
+            auto entityId = id != INVALID_ENTITY_ID
+                                ? s_entityStore->AddAt(id, record)
+                                : s_entityStore->Add(record);
+
+            if (entityId == INVALID_ENTITY_ID)
+            {
+                return INVALID_ENTITY_ID;
+            }
+
+            // both the signature and the dictionary are sorted, so the
+            //      components can be pushed with a single walk
+            auto it = components.begin();
+            for (u32 column = 0; column < archetype->types.size(); column++)
+            {
+                Ref<ComponentBase> component;
+
+                if (archetype->types[column] == typeid(DataComponent) && !restoring)
+                {
+                    component = CreatePooledRef<DataComponent>();
+
+                    if (it != components.end() && it->first == typeid(DataComponent))
+                    {
+                        it++;
+                    }
+                }
+                else
+                {
+                    component = (it++)->second;
+                }
+
+                component->entity_id = entityId;
+
+                if (archetype->types[column] == typeid(Geometry) &&
+                    currentLayer < MAX_LAYERS &&
+                    !restoring)
+                {
+                    std::static_pointer_cast<Geometry>(component)->priority +=
+                        (currentLayer * LAYER_PRIORITY_RANGE);
+                }
+
+                archetype->columns[column].push_back(component);
+                archetype->changedTicks[column].push_back(CurrentWriteTick());
+                archetype->addedTicks[column].push_back(CurrentWriteTick());
+            }
+            archetype->entities.push_back(entityId);
+            s_createdEntities++;
+
+            return entityId;
+        }
+
+        /**
+         * Reserve the ID of the entity which is created by a parallel system
+         *      and record its create command, nothing of the storage (entity
+         *      store, archetypes, columns) is changed until ApplyCommands.
+         */
+        entity_id_t ReserveEntity(
+            const String &name,
+            const Dictionary<std::type_index, Ref<ComponentBase>> &components)
+        {
+            auto entityId = s_entityStore->Reserve();
+
+            if (entityId == INVALID_ENTITY_ID)
+            {
+                return INVALID_ENTITY_ID;
+            }
+
+            EntityCommand command;
+            command.type = ENTITY_COMMAND_CREATE;
+            command.id = entityId;
+            command.layer = currentLayer;
+            command.inserting = TRUE;
+            command.name = name;
+            command.components = components;
+            RecordCommand(command);
+
+            return entityId;
+        }
+
+        void InsertReservedEntity(const EntityCommand &command)
+        {
+            // the layer priority of the Geometry uses the layer of the creation
+            layer_t definedLayer = currentLayer;
+            currentLayer = command.layer;
+
+            auto archetypeId = GetArchetype(SignatureOf(command.components));
+            InsertEntity(command.name, archetypeId, command.components, FALSE, command.id);
+
+            currentLayer = definedLayer;
+        }
+
+        void ApplyComponentActive(entity_id_t id, std::type_index type, b8 active)
+        {
+            PROFILE_FUNCTION();
+
+            auto record = s_entityStore->Get(id);
+
+            if (record == nullptr)
+            {
+                return;
+            }
+
+            auto archetype = s_archetypes[record->archetype];
+
+            // only the systems which match the archetype can contain the entity
+            for (auto systemId : archetype->systems)
+            {
+                auto system = s_systemsStore->Get(systemId);
+
+                if (!system->componentTypes.Contains(type))
+                {
+                    continue;
+                }
+
+                if (active)
+                {
+                    system->entities.Add(id);
+                }
+                else
+                {
+                    system->entities.RemoveItem(id);
+                }
+            }
+        }
+
+        /**
+         * Check if all the components of the entity which are needed by the
+         *      system are active
+         */
+        b8 IsSystemComponentsActive(Ref<SystemInfo> system,
+                                    Ref<Archetype> archetype,
+                                    u32 row)
+        {
+            for (auto type : system->componentTypes)
+            {
+                i32 column = archetype->ColumnOf(type);
+
+                if (column < 0 || !archetype->columns[column][row]->active)
+                {
+                    return FALSE;
+                }
+            }
+
+            return TRUE;
+        }
+
+        /**
+         * Move the entity into the archetype of the new signature, the
+         *      components are moved as is (with their ticks) and only the
+         *      added component (if any) is created in the new archetype.
+         *      The systems are not touched.
+         */
+        void MoveEntity(entity_id_t id,
+                        Ref<EntityRecord> record,
+                        archetype_id_t targetId,
+                        Ref<ComponentBase> addedComponent)
+        {
+            PROFILE_FUNCTION();
+
+            auto source = s_archetypes[record->archetype];
+            auto target = s_archetypes[targetId];
+            u32 sourceRow = record->row;
+            u32 targetRow = target->entities.size();
+            u32 tick = CurrentWriteTick();
+
+            for (u32 column = 0; column < target->types.size(); column++)
+            {
+                i32 sourceColumn = source->ColumnOf(target->types[column]);
+
+                if (sourceColumn < 0)
+                {
+                    target->columns[column].push_back(addedComponent);
+                    target->changedTicks[column].push_back(tick);
+                    target->addedTicks[column].push_back(tick);
+                    continue;
+                }
+
+                target->columns[column].push_back(source->columns[sourceColumn][sourceRow]);
+                target->changedTicks[column].push_back(source->changedTicks[sourceColumn][sourceRow]);
+                target->addedTicks[column].push_back(source->addedTicks[sourceColumn][sourceRow]);
+            }
+            target->entities.push_back(id);
+
+            ArchetypeRemoveRow(record->archetype, sourceRow);
+
+            record->archetype = targetId;
+            record->row = targetRow;
+        }
+
+        void ApplyAddComponent(entity_id_t id, std::type_index type, Ref<ComponentBase> component)
+        {
+            PROFILE_FUNCTION();
+
+            auto record = s_entityStore->Get(id);
+
+            if (record == nullptr || record->deleting)
+            {
+                return;
+            }
+
+            auto source = s_archetypes[record->archetype];
+
+            if (source->ColumnOf(type) >= 0)
+            {
+                NTT_ENGINE_WARN("The entity {} already has the component {}", id, type.name());
+                return;
+            }
+
+            List<std::type_index> signature = source->types;
+            signature.insert(std::lower_bound(signature.begin(), signature.end(), type), type);
+
+            archetype_id_t targetId = GetArchetype(signature);
+            archetype_id_t sourceId = record->archetype;
+
+            component->entity_id = id;
+            MoveEntity(id, record, targetId, component);
+            s_componentStructureChanges++;
+
+            if (!record->attached)
+            {
+                return;
+            }
+
+            // only the systems which need the new component are affected
+            auto target = s_archetypes[targetId];
+            List<system_id_t> joinedSystems;
+
+            for (auto systemId : target->systems)
+            {
+                if (s_archetypes[sourceId]->systems.Contains(systemId))
+                {
+                    continue;
+                }
+
+                auto system = s_systemsStore->Get(systemId);
+
+                if (IsSystemComponentsActive(system, target, record->row))
+                {
+                    system->entities.Add(id);
+                    joinedSystems.push_back(systemId);
+                }
+            }
+
+            for (auto systemId : joinedSystems)
+            {
+                if (s_entityStore->Get(id) == nullptr)
+                {
+                    break;
+                }
+
+                s_systemsStore->Get(systemId)->system->InitEntity(id);
+            }
+        }
+
+        void ApplyRemoveComponent(entity_id_t id, std::type_index type)
+        {
+            PROFILE_FUNCTION();
+
+            auto record = s_entityStore->Get(id);
+
+            if (record == nullptr || record->deleting)
+            {
+                return;
+            }
+
+            auto source = s_archetypes[record->archetype];
+
+            if (source->ColumnOf(type) < 0)
+            {
+                return;
+            }
+
+            List<std::type_index> signature = source->types;
+            signature.RemoveItem(type);
+
+            archetype_id_t targetId = GetArchetype(signature);
+            archetype_id_t sourceId = record->archetype;
+
+            // the systems can still read the component while shutting down
+            //      the entity, so they are notified before the move
+            if (record->attached)
+            {
+                auto target = s_archetypes[targetId];
+
+                for (auto systemId : s_archetypes[sourceId]->systems)
+                {
+                    if (target->systems.Contains(systemId))
+                    {
+                        continue;
+                    }
+
+                    auto system = s_systemsStore->Get(systemId);
+
+                    if (system->entities.Contains(id))
+                    {
+                        system->system->ShutdownEntity(id);
+                        system->entities.RemoveItem(id);
+                    }
+                }
+            }
+
+            // the entity can be deleted by the shutdown functions
+            record = s_entityStore->Get(id);
+
+            if (record == nullptr || record->deleting)
+            {
+                return;
+            }
+
+            MoveEntity(id, record, targetId, nullptr);
+            s_componentStructureChanges++;
+        }
+
+        /**
+         * Push the time of the system in the current frame into its window
+         */
+        void RecordSystemTiming(Ref<SystemInfo> system)
+        {
+            system->times[system->timesNext] = system->frameMicroseconds.load() / 1000.0f;
+            system->timesNext = (system->timesNext + 1) % ECS_STATS_WINDOW;
+            system->timesCount = std::min(system->timesCount + 1, (u32)ECS_STATS_WINDOW);
+            system->lastEntitiesCount = system->batch.size();
+        }
+
+        /**
+         * Apply all the recorded commands in the recorded order, the commands
+         *      which are recorded by the callbacks (InitEntity, ShutdownEntity,
+         *      events, ...) while applying are applied immediately.
+         */
+        void ApplyCommands()
+        {
+            PROFILE_FUNCTION();
+
+            List<EntityCommand> commands;
+
+            {
+                std::lock_guard<std::mutex> lock(s_commandsMutex);
+                commands.swap(s_commands);
+            }
+
+            // all the reserved entities are stored first, so the InitEntity of
+            //      each one can look up the others (like ECSCreateEntities)
+            for (auto &command : commands)
+            {
+                if (command.type == ENTITY_COMMAND_CREATE && command.inserting)
+                {
+                    InsertReservedEntity(command);
+                }
+            }
+
+            for (auto &command : commands)
+            {
+                switch (command.type)
+                {
+                case ENTITY_COMMAND_CREATE:
+                    if (s_entityStore->Contains(command.id) &&
+                        !s_entityStore->Get(command.id)->attached)
+                    {
+                        AttachEntity(command.id, command.layer);
+                    }
+                    break;
+                case ENTITY_COMMAND_DELETE:
+                    InternalEntityDelete(command.id);
+                    break;
+                case ENTITY_COMMAND_SET_COMPONENT_ACTIVE:
+                    ApplyComponentActive(command.id, command.componentType, command.active);
+                    break;
+                case ENTITY_COMMAND_ADD_COMPONENT:
+                    ApplyAddComponent(command.id, command.componentType, command.component);
+                    break;
+                case ENTITY_COMMAND_REMOVE_COMPONENT:
+                    ApplyRemoveComponent(command.id, command.componentType);
+                    break;
+                }
+            }
+        }
+
+        /**
+         * The column pointers of the archetype which is visited by a query
+         */
+        struct ChunkColumns
+        {
+            const List<Ref<ComponentBase>> *columns[MAX_QUERY_COMPONENTS];
+            List<u32> *changedTicks[MAX_QUERY_COMPONENTS];
+            const List<u32> *filterTicks[MAX_QUERY_FILTERS];
+            u32 filterSince[MAX_QUERY_FILTERS];
+        };
+
+        ArchetypeChunk PrepareChunk(ChunkColumns &chunkColumns,
+                                    const QueryFilter *filters,
+                                    u32 filtersCount)
+        {
+            for (u32 i = 0; i < filtersCount; i++)
+            {
+                chunkColumns.filterSince[i] = filters[i].since == QUERY_SINCE_LAST_RUN
+                                                  ? t_sinceTick
+                                                  : filters[i].since;
+            }
+
+            ArchetypeChunk chunk;
+            chunk.entities = nullptr;
+            chunk.rows = nullptr;
+            chunk.count = 0;
+            chunk.columns = chunkColumns.columns;
+            chunk.changedTicks = chunkColumns.changedTicks;
+            chunk.filterTicks = chunkColumns.filterTicks;
+            chunk.filterSince = chunkColumns.filterSince;
+            chunk.filtersCount = filtersCount;
+            chunk.tick = CurrentWriteTick();
+
+            return chunk;
+        }
+
+        /**
+         * Point the chunk columns to the queried columns of the archetype, if
+         *      the archetype misses any queried (or filtered) type, then
+         *      return FALSE
+         */
+        b8 ResolveChunkColumns(Archetype &archetype,
+                               const component_type_id_t *types,
+                               u32 typesCount,
+                               const QueryFilter *filters,
+                               u32 filtersCount,
+                               ChunkColumns &chunkColumns)
+        {
+            for (u32 i = 0; i < typesCount; i++)
+            {
+                if (types[i] >= archetype.typeIdColumns.size() ||
+                    archetype.typeIdColumns[types[i]] < 0)
+                {
+                    return FALSE;
+                }
+
+                auto column = archetype.typeIdColumns[types[i]];
+                chunkColumns.columns[i] = &archetype.columns[column];
+                chunkColumns.changedTicks[i] = &archetype.changedTicks[column];
+            }
+
+            for (u32 i = 0; i < filtersCount; i++)
+            {
+                auto typeId = filters[i].componentType;
+
+                if (typeId >= archetype.typeIdColumns.size() ||
+                    archetype.typeIdColumns[typeId] < 0)
+                {
+                    return FALSE;
+                }
+
+                auto column = archetype.typeIdColumns[typeId];
+                chunkColumns.filterTicks[i] = filters[i].type == QUERY_FILTER_ADDED
+                                                  ? &archetype.addedTicks[column]
+                                                  : &archetype.changedTicks[column];
+            }
+
+            return TRUE;
+        }
+
+        /**
+         * Drop the recorded commands of the entities which are deleted with
+         *      their layer, the freed IDs can be given to the other entities
+         *      before the commands are applied
+         */
+        void DropCommandsOfLayer(layer_t layer)
+        {
+            std::lock_guard<std::mutex> lock(s_commandsMutex);
+
+            s_commands.erase(
+                std::remove_if(
+                    s_commands.begin(),
+                    s_commands.end(),
+                    [layer](const EntityCommand &command)
+                    {
+                        return command.inserting
+                                   ? command.layer == layer
+                                   : !s_entityStore->Contains(command.id);
+                    }),
+                s_commands.end());
+        }
+
+        void BeginDefer()
+        {
+            s_deferDepth++;
+        }
+
+        void EndDefer()
+        {
+            if (--s_deferDepth == 0)
+            {
+                ApplyCommands();
+            }
+        }
+
+        /**
+         * Delete all the entities of the layer (and the ones which are created
+         *      in this frame), the slots are freed right away
+         */
+        void ClearLayerNow(layer_t layer)
+        {
+            List<entity_id_t> entities = layers[layer]->Values();
+
+            {
+                // the entities which are created in this frame are not in the layer yet
+                std::lock_guard<std::mutex> lock(s_commandsMutex);
+
+                for (auto &command : s_commands)
+                {
+                    if (command.type == ENTITY_COMMAND_CREATE &&
+                        command.layer == layer &&
+                        !command.inserting)
+                    {
+                        entities.push_back(command.id);
+                    }
+                }
+            }
+
+            // the slots are freed right away (even inside ECSUpdate), so the
+            //      restored entities (see ECSRestore) can take their IDs back
+            for (auto entity : entities)
+            {
+                InternalEntityDelete(entity);
+            }
+
+            DropCommandsOfLayer(layer);
+        }
+
+        /**
+         * The chunks of a query are visited between BeginChunkVisit and
+         *      EndChunkVisit, the layers which are cleared meanwhile are
+         *      cleared when the outermost visit is finished
+         */
+        void BeginChunkVisit()
+        {
+            BeginDefer();
+            s_chunkVisitDepth++;
+        }
+
+        void EndChunkVisit()
+        {
+            if (--s_chunkVisitDepth == 0)
+            {
+                List<layer_t> pendingLayers;
+
+                {
+                    std::lock_guard<std::mutex> lock(s_commandsMutex);
+                    pendingLayers.swap(s_pendingClearLayers);
+                }
+
+                for (auto layer : pendingLayers)
+                {
+                    ClearLayerNow(layer);
+                }
+            }
+
+            EndDefer();
+        }
+
+
+        /**
+         * Keep the Geometry of the entities before the fixed step, so the
+         *      drawn state is interpolated between the last two steps (the
+         *      history is not a change of the component)
+         */
+        void CaptureGeometries(Span<const entity_id_t> batch)
+        {
+            PROFILE_FUNCTION();
+
+            for (auto id : batch)
+            {
+                auto geo = std::static_pointer_cast<Geometry>(
+                    ECSGetEntityComponent(id, typeid(Geometry), FALSE));
+
+                if (geo == nullptr || geo->lastStep == s_fixedStepIndex)
+                {
+                    continue;
+                }
+
+                geo->lastPos = geo->pos;
+                geo->lastRotation = geo->rotation;
+                geo->lastStep = s_fixedStepIndex;
+            }
+        }
+
+        /**
+         * Update the systems of the given pass stage by stage, the structural
+         *      changes are applied at the end of the pass
+         */
+        void UpdateStages(f32 delta, UpdatePass pass)
+        {
+            List<Job> jobs;
+            u32 workersCount = ThreadPoolGetWorkersCount();
+
+            // the structural changes are recorded while the systems are updated
+            BeginDefer();
+
+            for (auto &stage : s_stages)
+            {
+                jobs.clear();
+
+                for (auto systemId : stage)
+                {
+                    auto system = s_systemsStore->Get(systemId);
+
+                    if (!system->active ||
+                        (pass == UPDATE_PASS_BEFORE_FIXED && !system->beforeFixed) ||
+                        (pass == UPDATE_PASS_FIXED && !system->fixedStep) ||
+                        (pass == UPDATE_PASS_AFTER_FIXED &&
+                         (system->fixedStep || system->beforeFixed)))
+                    {
+                        continue;
+                    }
+
+                    // the batch is a copy (the buffer is reused between frames) so the
+                    //      systems can create or delete entities while updating
+                    system->batch.clear();
+
+                    for (auto entityId : system->entities)
+                    {
+                        if (system->alwayUpdate)
+                        {
+                            if (!s_DrawnEntities.Contains(entityId))
+                            {
+                                continue;
+                            }
+                        }
+                        else
+                        {
+                            if (!s_UpdatedEntities.Contains(entityId))
+                            {
+                                continue;
+                            }
+                        }
+
+                        system->batch.push_back(entityId);
+                    }
+
+                    if (system->batch.empty())
+                    {
+                        continue;
+                    }
+
+                    Span<const entity_id_t> batch = system->batch;
+
+                    if (pass == UPDATE_PASS_FIXED)
+                    {
+                        CaptureGeometries(batch);
+                    }
+
+                    // each system writes its own tick, so it doesn't see its own
+                    //      changes but sees all the changes of the others
+                    system->runTick = ++s_changeTick;
+                    system->frameMicroseconds = 0;
+
+                    if (!system->access.IsDeclared())
+                    {
+                        // the undeclared system is conflicted with all others so it
+                        //      is the only system of its stage
+                        UpdateSystemBatch(system, delta, batch);
+                        continue;
+                    }
+
+                    u32 chunkSize = batch.size();
+
+                    if (system->access.splittable && workersCount > 0)
+                    {
+                        chunkSize = (batch.size() + workersCount) / (workersCount + 1);
+                        chunkSize = std::max(chunkSize, (u32)MIN_CHUNK_SIZE);
+                    }
+
+                    for (u32 start = 0; start < batch.size(); start += chunkSize)
+                    {
+                        auto chunk = batch.SubSpan(start, chunkSize);
+                        jobs.push_back([system, delta, chunk]()
+                                       {
+                                           t_parallelUpdate = TRUE;
+                                           UpdateSystemBatch(system, delta, chunk);
+                                           t_parallelUpdate = FALSE; });
+                    }
+                }
+
+                ThreadPoolRun(jobs);
+
+                for (auto systemId : stage)
+                {
+                    auto system = s_systemsStore->Get(systemId);
+
+                    // only the systems which are updated in this frame
+                    if (system->runTick > system->lastRunTick)
+                    {
+                        RecordSystemTiming(system);
+                    }
+
+                    system->lastRunTick = std::max(system->lastRunTick, system->runTick);
+                }
+            }
+
+            // the changes which are made outside ECSUpdate (and the deferred
+            //      entities) are newer than all the system updates of this frame
+            s_changeTick++;
+            EndDefer();
+        }
+    } // namespace
+
+    void ECSInit()
+    {
+        PROFILE_FUNCTION();
+
+        s_entityStore = CreateScope<EntityStore>();
+
+        s_systemsStore = CreateScope<Store<system_id_t, SystemInfo>>(
+            0,
+            1000,
+            [](Ref<SystemInfo> a, Ref<SystemInfo> b) -> b8
+            { return a->name == b->name; },
+            [](Ref<SystemInfo> system) -> String
+            { return system->name; });
+
+        s_archetypes.clear();
+        s_archetypeIds.clear();
+
+        s_stages.clear();
+        s_stagesDirty = TRUE;
+        s_changeTick = 1;
+
+        s_fixedStepTime = 0.0f;
+        s_maxFixedSteps = ECS_MAX_FIXED_STEPS;
+        s_fixedStepAccumulator = 0.0f;
+        s_fixedStepIndex = 0;
+
+        s_DrawnEntities.clear();
+        s_UpdatedEntities.clear();
+
+        s_deferDepth = 0;
+        s_commands.clear();
+        s_chunkVisitDepth = 0;
+        s_pendingClearLayers.clear();
+
+        s_createdEntities = 0;
+        s_deletedEntities = 0;
+        s_componentStateChanges = 0;
+        s_componentStructureChanges = 0;
+        s_frameStats = {};
+
+        s_selectedEntities.clear();
+
+        // RegisterEvent(NTT_LAYER_CHANGED, std::bind(OnSceneOpened));
+        memset(layers, 0, sizeof(layers));
+
+        for (auto i = 0; i < MAX_LAYERS; i++)
+        {
+            layers[i] = CreateScope<SparseSet<entity_id_t, EntityIndexOf>>();
+        }
+
+        currentLayer = GAME_LAYER;
+        currentRunningLayer = GAME_LAYER;
+        uiLayerVisible = INVALID_UI_LAYER;
+    }
+
+    void ECSRegister(String name, Ref<System> system,
+                     List<std::type_index> componentTypes,
+                     b8 alwayUpdate,
+                     const SystemAccess &access,
+                     b8 fixedStep)
+    {
+        PROFILE_FUNCTION();
+
+        auto systemId = s_systemsStore->Add(CreateRef<SystemInfo>(
+            // GetName(name),
+            name,
+            system,
+            componentTypes,
+            alwayUpdate,
+            access,
+            fixedStep));
+
+        s_stagesDirty = TRUE;
+
+        for (auto archetype : s_archetypes)
+        {
+            if (archetype->systems.Contains(systemId))
+            {
+                continue;
+            }
+
+            if (IsSignatureMatched(archetype->types, componentTypes))
+            {
+                archetype->systems.push_back(systemId);
+            }
+        }
+
+        system->InitSystem();
+    }
+
+    void ECSChangeSystemState(String name, b8 active)
+    {
+        PROFILE_FUNCTION();
+
+        auto &systemIds = s_systemsStore->GetIdsByKey(name);
+
+        if (systemIds.size() != 1)
+        {
+            NTT_ENGINE_WARN("The system with name {} is not found", name);
+            return;
+        }
+
+        s_systemsStore->Get(systemIds[0])->active = active;
+    }
+
+    void ECSBeginLayer(layer_t layer)
+    {
+        PROFILE_FUNCTION();
+
+        if (layer >= MAX_LAYERS)
+        {
+            return;
+        }
+
+        currentLayer = layer;
+
+        EventContext context;
+        context.u16_data[0] = currentLayer;
+        TriggerEvent(NTT_DEFINED_LAYER_CHANGED, nullptr, context);
+    }
+
+    void ECS_ClearLayer(layer_t layer)
+    {
+        PROFILE_FUNCTION();
+
+        if (layer >= MAX_LAYERS)
+        {
+            return;
+        }
+
+        if (s_chunkVisitDepth > 0)
+        {
+            std::lock_guard<std::mutex> lock(s_commandsMutex);
+
+            if (!s_pendingClearLayers.Contains(layer))
+            {
+                s_pendingClearLayers.push_back(layer);
+            }
+
+            return;
+        }
+
+        ClearLayerNow(layer);
+    }
+
+    List<entity_id_t> ECS_GetAllEntitiesIn(layer_t layer)
+    {
+        PROFILE_FUNCTION();
+
+        if (layer >= MAX_LAYERS)
+        {
+            return {};
+        }
+
+        return layers[layer]->Values();
+    }
+
+    void ECSLayerMakeVisible(layer_t layer)
+    {
+        PROFILE_FUNCTION();
+
+        if (layer >= MAX_LAYERS)
+        {
+            return;
+        }
+
+        if (GAME_LAYER < layer && layer < EDITOR_LAYER)
+        {
+            uiLayerVisible = layer;
+        }
+
+        if (layer == GAME_LAYER)
+        {
+            uiLayerVisible = INVALID_UI_LAYER;
+        }
+
+        currentRunningLayer = layer;
+
+        ResetEntitiesState();
+
+        EventContext context;
+        context.u16_data[0] = currentRunningLayer;
+        TriggerEvent(NTT_LAYER_CHANGED, nullptr, context);
+    }
 
-        s_entityStore = CreateScope<Store<entity_id_t, EntityInfo>>(
-            0,
-            1000,
-            [](Ref<EntityInfo> a, Ref<EntityInfo> b) -> b8
-            { return FALSE; });
+    List<entity_id_t> ECSGetEntitiesWithSystem(String name)
+    {
+        PROFILE_FUNCTION();
 
-        s_systemsStore = CreateScope<Store<system_id_t, SystemInfo>>(
-            0,
-            1000,
-            [](Ref<SystemInfo> a, Ref<SystemInfo> b) -> b8
-            { return a->name == b->name; });
+        auto &systemIds = s_systemsStore->GetIdsByKey(name);
 
-        s_DrawnEntities.clear();
-        s_UpdatedEntities.clear();
-        s_deletedEntities.clear();
+        if (systemIds.size() != 1)
+        {
+            return {};
+        }
 
-        s_selectedEntities.clear();
+        List<entity_id_t> entities = s_systemsStore->Get(systemIds[0])->entities.Values();
+        entities.Sorted();
 
-        // RegisterEvent(NTT_LAYER_CHANGED, std::bind(OnSceneOpened));
-        memset(layers, 0, sizeof(layers));
+        return entities;
+    }
 
-        for (auto i = 0; i < MAX_LAYERS; i++)
+    entity_id_t ECSCreateEntity(
+        const String &name,
+        Dictionary<std::type_index, Ref<ComponentBase>> components)
+    {
+        PROFILE_FUNCTION();
+
+        if (t_parallelUpdate)
+        {
+            return ReserveEntity(name, components);
+        }
+
+        auto archetypeId = GetArchetype(SignatureOf(components));
+        auto entityId = InsertEntity(name, archetypeId, components);
+
+        if (entityId == INVALID_ENTITY_ID)
+        {
+            return INVALID_ENTITY_ID;
+        }
+
+        AttachOrRecordEntities(Span<const entity_id_t>(&entityId, 1), currentLayer);
+
+        // OnSceneOpened();
+
+        return entityId;
+    }
+
+    List<entity_id_t> ECSCreateEntities(Span<const Ref<EntityInfo>> entities)
+    {
+        PROFILE_FUNCTION();
+
+        List<entity_id_t> entityIds;
+        List<archetype_id_t> archetypeIds;
+        entityIds.reserve(entities.size());
+        archetypeIds.reserve(entities.size());
+
+        if (t_parallelUpdate)
+        {
+            for (auto &entity : entities)
+            {
+                entityIds.push_back(ReserveEntity(entity->name, entity->components));
+            }
+
+            return entityIds;
+        }
+
+        // resolve the archetypes (and their systems) once per signature
+        //      then reserve the rows of each archetype once
+        Dictionary<archetype_id_t, u32> rowsCount;
+
+        for (auto &entity : entities)
+        {
+            auto archetypeId = GetArchetype(SignatureOf(entity->components));
+            archetypeIds.push_back(archetypeId);
+            rowsCount[archetypeId]++;
+        }
+
+        for (auto &pair : rowsCount)
+        {
+            auto archetype = s_archetypes[pair.first];
+            u32 rows = archetype->entities.size() + pair.second;
+
+            archetype->entities.reserve(rows);
+            for (u32 i = 0; i < archetype->columns.size(); i++)
+            {
+                archetype->columns[i].reserve(rows);
+                archetype->changedTicks[i].reserve(rows);
+                archetype->addedTicks[i].reserve(rows);
+            }
+        }
+
+        List<entity_id_t> createdIds;
+        createdIds.reserve(entities.size());
+
+        for (u32 i = 0; i < entities.size(); i++)
+        {
+            auto entityId = InsertEntity(
+                entities[i]->name,
+                archetypeIds[i],
+                entities[i]->components);
+
+            entityIds.push_back(entityId);
+
+            if (entityId != INVALID_ENTITY_ID)
+            {
+                createdIds.push_back(entityId);
+            }
+        }
+
+        AttachOrRecordEntities(createdIds, currentLayer);
+
+        return entityIds;
+    }
+
+    Ref<WorldSnapshot> ECSSnapshot(const List<layer_t> &snapshotLayers)
+    {
+        PROFILE_FUNCTION();
+
+        auto snapshot = CreateRef<WorldSnapshot>();
+        snapshot->layers = snapshotLayers;
+
+        // the entities are captured archetype by archetype, so the restored
+        //      entities are inserted into the same archetype in a row
+        for (u32 archetypeId = 0; archetypeId < s_archetypes.size(); archetypeId++)
+        {
+            auto archetype = s_archetypes[archetypeId];
+
+            for (u32 row = 0; row < archetype->entities.size(); row++)
+            {
+                auto entityId = archetype->entities[row];
+                auto record = s_entityStore->Get(entityId);
+
+                if (record == nullptr || record->deleted)
+                {
+                    continue;
+                }
+
+                layer_t entityLayer = MAX_LAYERS;
+
+                for (auto layer : snapshotLayers)
+                {
+                    if (layer < MAX_LAYERS && layers[layer]->Contains(entityId))
+                    {
+                        entityLayer = layer;
+                        break;
+                    }
+                }
+
+                if (entityLayer == MAX_LAYERS)
+                {
+                    continue;
+                }
+
+                WorldSnapshot::Entity entity;
+                entity.id = entityId;
+                entity.name = record->name;
+                entity.layer = entityLayer;
+                entity.firstComponent = snapshot->components.size();
+                entity.componentsCount = 0;
+
+                for (u32 column = 0; column < archetype->columns.size(); column++)
+                {
+                    auto component = archetype->columns[column][row];
+                    auto clone = component->Clone();
+
+                    if (clone == nullptr)
+                    {
+                        NTT_ENGINE_WARN("The component {} cannot be cloned, it's skipped",
+                                        component->GetName());
+                        continue;
+                    }
+
+                    clone->active = component->active;
+
+                    snapshot->types.push_back(archetype->types[column]);
+                    snapshot->components.push_back(clone);
+                    entity.componentsCount++;
+                }
+
+                snapshot->entities.push_back(entity);
+            }
+        }
+
+        return snapshot;
+    }
+
+    List<entity_id_t> ECSRestore(Ref<WorldSnapshot> snapshot)
+    {
+        PROFILE_FUNCTION();
+
+        if (snapshot == nullptr)
+        {
+            return {};
+        }
+
+        for (auto layer : snapshot->layers)
+        {
+            ECS_ClearLayer(layer);
+        }
+
+        u32 entitiesCount = snapshot->entities.size();
+        List<Dictionary<std::type_index, Ref<ComponentBase>>> entitiesComponents;
+        List<archetype_id_t> archetypeIds;
+        List<entity_id_t> entityIds;
+        entitiesComponents.resize(entitiesCount);
+        archetypeIds.resize(entitiesCount);
+        entityIds.resize(entitiesCount, INVALID_ENTITY_ID);
+
+        for (u32 i = 0; i < entitiesCount; i++)
+        {
+            auto &entity = snapshot->entities[i];
+
+            for (u32 j = 0; j < entity.componentsCount; j++)
+            {
+                auto component = snapshot->components[entity.firstComponent + j]->Clone();
+
+                // the inactive components are turned off after being attached
+                component->active = TRUE;
+                entitiesComponents[i][snapshot->types[entity.firstComponent + j]] = component;
+            }
+
+            archetypeIds[i] = GetArchetype(SignatureOf(entitiesComponents[i]));
+        }
+
+        // all the captured IDs are claimed first, so the entities which
+        //      receive the new IDs do not take the slots of the others
+        for (u32 i = 0; i < entitiesCount; i++)
+        {
+            entityIds[i] = InsertEntity(
+                snapshot->entities[i].name,
+                archetypeIds[i],
+                entitiesComponents[i],
+                TRUE,
+                snapshot->entities[i].id);
+        }
+
+        Dictionary<entity_id_t, entity_id_t> remappedIds;
+
+        for (u32 i = 0; i < entitiesCount; i++)
+        {
+            if (entityIds[i] != INVALID_ENTITY_ID)
+            {
+                continue;
+            }
+
+            entityIds[i] = InsertEntity(
+                snapshot->entities[i].name,
+                archetypeIds[i],
+                entitiesComponents[i],
+                TRUE);
+            remappedIds[snapshot->entities[i].id] = entityIds[i];
+        }
+
+        // the references between the restored entities must be fixed before
+        //      any system sees them
+        if (!remappedIds.empty())
+        {
+            for (auto entityId : entityIds)
+            {
+                auto record = s_entityStore->Get(entityId);
+
+                if (record == nullptr)
+                {
+                    continue;
+                }
+
+                for (auto &column : s_archetypes[record->archetype]->columns)
+                {
+                    column[record->row]->RemapEntities(remappedIds);
+                }
+            }
+        }
+
+        for (auto layer : snapshot->layers)
+        {
+            List<entity_id_t> layerIds;
+
+            for (u32 i = 0; i < snapshot->entities.size(); i++)
+            {
+                if (snapshot->entities[i].layer == layer && entityIds[i] != INVALID_ENTITY_ID)
+                {
+                    layerIds.push_back(entityIds[i]);
+                }
+            }
+
+            AttachOrRecordEntities(layerIds, layer);
+        }
+
+        for (u32 i = 0; i < entitiesCount; i++)
+        {
+            auto &entity = snapshot->entities[i];
+
+            for (u32 j = 0; j < entity.componentsCount && entityIds[i] != INVALID_ENTITY_ID; j++)
+            {
+                if (!snapshot->components[entity.firstComponent + j]->active)
+                {
+                    ECSSetComponentActive(entityIds[i],
+                                          snapshot->types[entity.firstComponent + j],
+                                          FALSE);
+                }
+            }
+        }
+
+        return entityIds;
+    }
+
+    Ref<EntityInfo> ECSGetEntity(entity_id_t id)
+    {
+        PROFILE_FUNCTION();
+
+        auto record = s_entityStore->Get(id);
+
+        if (record == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto archetype = s_archetypes[record->archetype];
+        auto entityInfo = CreateRef<EntityInfo>();
+        entityInfo->name = record->name;
+
+        for (u32 i = 0; i < archetype->types.size(); i++)
+        {
+            entityInfo->components[archetype->types[i]] = archetype->columns[i][record->row];
+            archetype->changedTicks[i][record->row] = CurrentWriteTick();
+        }
+
+        return entityInfo;
+    }
+
+    b8 ECSIsEntityValid(entity_id_t id)
+    {
+        auto record = s_entityStore->Get(id);
+        return record != nullptr && !record->deleted;
+    }
+
+    entity_id_t ECSGetEntityByName(const String &name)
+    {
+        PROFILE_FUNCTION();
+
+        auto &ids = s_entityStore->GetIdsByName(name);
+
+        if (ids.size() != 1)
+        {
+            return INVALID_ENTITY_ID;
+        }
+
+        return ids[0];
+    }
+
+    component_type_id_t ECSGetComponentTypeId(std::type_index type)
+    {
+        std::lock_guard<std::mutex> lock(s_componentTypeIdsMutex);
+
+        auto it = s_componentTypeIds.find(type);
+        if (it != s_componentTypeIds.end())
+        {
+            return it->second;
+        }
+
+        component_type_id_t id = s_componentTypeIds.size();
+        s_componentTypeIds[type] = id;
+
+        return id;
+    }
+
+    u32 ECSGetChangeTick()
+    {
+        return CurrentWriteTick() - 1;
+    }
+
+    u32 ECSGetLastRunTick()
+    {
+        return t_sinceTick;
+    }
+
+    void ECSForEachChunk(const component_type_id_t *types,
+                         u32 typesCount,
+                         const QueryFilter *filters,
+                         u32 filtersCount,
+                         ArchetypeChunkFunc func,
+                         void *userData)
+    {
+        PROFILE_FUNCTION();
+
+        ASSERT_M(typesCount <= MAX_QUERY_COMPONENTS, "Too many component types in the query");
+        ASSERT_M(filtersCount <= MAX_QUERY_FILTERS, "Too many filters in the query");
+
+        ChunkColumns chunkColumns;
+        ArchetypeChunk chunk = PrepareChunk(chunkColumns, filters, filtersCount);
+
+        BeginChunkVisit();
+
+        // the archetypes which are created inside the function are not visited
+        u32 archetypesCount = s_archetypes.size();
+
+        for (u32 archetypeId = 0; archetypeId < archetypesCount; archetypeId++)
+        {
+            auto &archetype = s_archetypes[archetypeId];
+
+            if (archetype->entities.empty() ||
+                !ResolveChunkColumns(*archetype, types, typesCount, filters, filtersCount, chunkColumns))
+            {
+                continue;
+            }
+
+            chunk.entities = &archetype->entities;
+            chunk.count = archetype->entities.size();
+
+            func(chunk, userData);
+        }
+
+        EndChunkVisit();
+    }
+
+    void ECSForEachChunkOf(Span<const entity_id_t> ids,
+                           const component_type_id_t *types,
+                           u32 typesCount,
+                           const QueryFilter *filters,
+                           u32 filtersCount,
+                           ArchetypeChunkFunc func,
+                           void *userData)
+    {
+        PROFILE_FUNCTION();
+
+        ASSERT_M(typesCount <= MAX_QUERY_COMPONENTS, "Too many component types in the query");
+        ASSERT_M(filtersCount <= MAX_QUERY_FILTERS, "Too many filters in the query");
+
+        ChunkColumns chunkColumns;
+        ArchetypeChunk chunk = PrepareChunk(chunkColumns, filters, filtersCount);
+
+        List<u32> rows;
+        rows.reserve(ids.size());
+
+        archetype_id_t archetypeId = INVALID_ENTITY_ID;
+        b8 matched = FALSE;
+
+        auto flush = [&]()
+        {
+            if (!rows.empty())
+            {
+                chunk.entities = &s_archetypes[archetypeId]->entities;
+                chunk.rows = rows.data();
+                chunk.count = rows.size();
+
+                func(chunk, userData);
+                rows.clear();
+            }
+        };
+
+        BeginChunkVisit();
+
+        // the rows do not move while visiting since the deletions are deferred
+        for (auto id : ids)
         {
-            layers[i] = CreateScope<List<entity_id_t>>();
+            auto record = s_entityStore->Get(id);
+
+            if (record == nullptr || record->deleted)
+            {
+                continue;
+            }
+
+            if (record->archetype != archetypeId)
+            {
+                flush();
+
+                archetypeId = record->archetype;
+                matched = ResolveChunkColumns(*s_archetypes[archetypeId],
+                                              types, typesCount,
+                                              filters, filtersCount,
+                                              chunkColumns);
+            }
+
+            if (matched)
+            {
+                rows.push_back(record->row);
+            }
         }
 
-        currentLayer = GAME_LAYER;
-        currentRunningLayer = GAME_LAYER;
-        uiLayerVisible = INVALID_UI_LAYER;
+        flush();
+
+        EndChunkVisit();
     }
 
-    void ECSRegister(String name, Ref<System> system,
-                     List<std::type_index> componentTypes,
-                     b8 alwayUpdate)
+    Ref<ComponentBase> ECSGetEntityComponent(entity_id_t id, std::type_index type, b8 markChanged)
     {
         PROFILE_FUNCTION();
 
-        auto systemId = s_systemsStore->Add(CreateRef<SystemInfo>(
-            // GetName(name),
-            name,
-            system,
-            componentTypes,
-            alwayUpdate));
+        auto record = s_entityStore->Get(id);
 
-        for (auto i = 0; i < componentTypes.size(); i++)
+        if (record == nullptr)
         {
-            std::type_index type = componentTypes[i];
+            NTT_ENGINE_TRACE("The entity with ID {} is not existed", id);
+            return nullptr;
         }
 
-        system->InitSystem();
-    }
-
-    void ECSChangeSystemState(String name, b8 active)
-    {
-        PROFILE_FUNCTION();
+        auto archetype = s_archetypes[record->archetype];
+        auto column = archetype->ColumnOf(type);
 
-        auto system = s_systemsStore->GetByField<String>(
-            name,
-            [](Ref<SystemInfo> system) -> String
-            { return system->name; });
+        if (column < 0)
+        {
+            NTT_ENGINE_TRACE("The component with type {} is not existed in the entity",
+                             type.name());
+            return nullptr;
+        }
 
-        if (system.size() != 1)
+        if (markChanged && !IsDeclaredRead(type))
         {
-            NTT_ENGINE_WARN("The system with name {} is not found", name);
-            return;
+            archetype->changedTicks[column][record->row] = CurrentWriteTick();
         }
 
-        system[0]->active = active;
+        return archetype->columns[column][record->row];
     }
 
-    void ECSBeginLayer(layer_t layer)
+    void ECSMarkComponentChanged(entity_id_t id, std::type_index type)
     {
         PROFILE_FUNCTION();
 
-        if (layer >= MAX_LAYERS)
+        auto record = s_entityStore->Get(id);
+
+        if (record == nullptr)
         {
             return;
         }
 
-        currentLayer = layer;
+        auto archetype = s_archetypes[record->archetype];
+        auto column = archetype->ColumnOf(type);
 
-        EventContext context;
-        context.u16_data[0] = currentLayer;
-        TriggerEvent(NTT_DEFINED_LAYER_CHANGED, nullptr, context);
+        if (column < 0)
+        {
+            return;
+        }
+
+        archetype->changedTicks[column][record->row] = CurrentWriteTick();
     }
 
-    void ECS_ClearLayer(layer_t layer)
+    b8 ECSIsComponentChanged(entity_id_t id, std::type_index type, u32 since)
     {
         PROFILE_FUNCTION();
 
-        if (layer >= MAX_LAYERS)
+        auto record = s_entityStore->Get(id);
+
+        if (record == nullptr)
         {
-            return;
+            return FALSE;
         }
 
-        List<entity_id_t> entities = *layers[layer];
+        auto archetype = s_archetypes[record->archetype];
+        auto column = archetype->ColumnOf(type);
 
-        for (auto entity : entities)
+        if (column < 0)
         {
-            InternalEntityDelete(entity);
+            return FALSE;
         }
-    }
-
-    List<entity_id_t> ECS_GetAllEntitiesIn(layer_t layer)
-    {
-        PROFILE_FUNCTION();
 
-        if (layer >= MAX_LAYERS)
+        if (since == QUERY_SINCE_LAST_RUN)
         {
-            return {};
+            since = t_sinceTick;
         }
 
-        return *layers[layer];
+        return archetype->changedTicks[column][record->row] > since;
     }
 
-    void ECSLayerMakeVisible(layer_t layer)
+    b8 ECSIsComponentAdded(entity_id_t id, std::type_index type, u32 since)
     {
         PROFILE_FUNCTION();
 
-        if (layer >= MAX_LAYERS)
-        {
-            return;
-        }
+        auto record = s_entityStore->Get(id);
 
-        if (GAME_LAYER < layer && layer < EDITOR_LAYER)
+        if (record == nullptr)
         {
-            uiLayerVisible = layer;
+            return FALSE;
         }
 
-        if (layer == GAME_LAYER)
+        auto archetype = s_archetypes[record->archetype];
+        auto column = archetype->ColumnOf(type);
+
+        if (column < 0)
         {
-            uiLayerVisible = INVALID_UI_LAYER;
+            return FALSE;
         }
 
-        currentRunningLayer = layer;
-
-        ResetEntitiesState();
-
-        EventContext context;
-        context.u16_data[0] = currentRunningLayer;
-        TriggerEvent(NTT_LAYER_CHANGED, nullptr, context);
-    }
-
-    List<entity_id_t> ECSGetEntitiesWithSystem(String name)
-    {
-        PROFILE_FUNCTION();
-
-        auto system = s_systemsStore->GetByField<String>(
-            name,
-            [](Ref<SystemInfo> system) -> String
-            { return system->name; });
-
-        if (system.size() != 1)
+        if (since == QUERY_SINCE_LAST_RUN)
         {
-            return {};
+            since = t_sinceTick;
         }
 
-        return system[0]->entities;
+        return archetype->addedTicks[column][record->row] > since;
     }
 
-    entity_id_t ECSCreateEntity(
-        const String &name,
-        Dictionary<std::type_index, Ref<ComponentBase>> components)
+    void ECSSetComponentActive(entity_id_t id, std::type_index type, b8 active)
     {
         PROFILE_FUNCTION();
 
-        components[typeid(DataComponent)] = CreateRef<DataComponent>();
-
-        auto entityInfo = CreateRef<EntityInfo>();
-        entityInfo->components = components;
-        auto entityId = s_entityStore->Add(entityInfo);
-        s_entityStore->Get(entityId)->name = name;
-
-        components.ForEach(
-            [&entityId](const std::type_index &,
-                        const Ref<ComponentBase> &component)
-            { component->entity_id = entityId; });
-
-        auto availableSystems = s_systemsStore->GetAvailableIds();
+        auto record = s_entityStore->Get(id);
 
-        for (auto systemId : availableSystems)
+        if (record == nullptr)
         {
-            if (IsEntityInSystem(systemId, entityId))
-            {
-                auto system = s_systemsStore->Get(systemId);
-                system->entities.push_back(entityId);
-            }
+            NTT_ENGINE_TRACE("The entity with ID {} is not existed", id);
+            return;
         }
 
-        // the entity must be added to all the systems which need the components
-        //     before the init function is called
-        for (auto systemId : availableSystems)
-        {
-            auto system = s_systemsStore->Get(systemId);
-            if (system->entities.Contains(entityId))
-            {
-                system->system->InitEntity(entityId);
-            }
-        }
+        auto archetype = s_archetypes[record->archetype];
+        auto column = archetype->ColumnOf(type);
 
-        if (currentLayer > MAX_LAYERS)
+        if (column < 0)
         {
-            return INVALID_ENTITY_ID;
+            NTT_ENGINE_TRACE("The component with type {} is not existed in the entity",
+                             type.name());
+            return;
         }
 
-        if (layers[currentLayer]->Contains(entityId))
+        auto component = archetype->columns[column][record->row];
+
+        if (component->active != active)
         {
-            return INVALID_ENTITY_ID;
+            s_componentStateChanges++;
         }
 
-        layers[currentLayer]->push_back(entityId);
-
-        auto geo = ECS_GET_COMPONENT(entityId, Geometry);
+        component->active = active;
+        archetype->changedTicks[column][record->row] = CurrentWriteTick();
 
-        if (geo != nullptr)
+        if (IsDeferring())
         {
-            geo->priority += (currentLayer * LAYER_PRIORITY_RANGE);
+            EntityCommand command;
+            command.type = ENTITY_COMMAND_SET_COMPONENT_ACTIVE;
+            command.id = id;
+            command.componentType = type;
+            command.active = active;
+            RecordCommand(command);
+            return;
         }
 
-        ResetEntitiesState();
-
-        NTT_ENGINE_TRACE("Entit {} has id {}", name, entityId);
-        EventContext context;
-        // must be changed when the entity_id_t is changed
-        context.u32_data[0] = entityId;
-        TriggerEvent(NTT_ENTITY_CREATED, nullptr, context);
-
-        // OnSceneOpened();
-
-        return entityId;
+        ApplyComponentActive(id, type, active);
     }
 
-    Ref<EntityInfo> ECSGetEntity(entity_id_t id)
+    void ECSAddComponent(entity_id_t id, std::type_index type, Ref<ComponentBase> component)
     {
         PROFILE_FUNCTION();
 
-        return s_entityStore->Get(id);
-    }
+        auto record = s_entityStore->Get(id);
 
-    entity_id_t ECSGetEntityByName(const String &name)
-    {
-        PROFILE_FUNCTION();
+        if (record == nullptr || record->deleted)
+        {
+            NTT_ENGINE_WARN("The entity with ID {} is not existed", id);
+            return;
+        }
 
-        List<entity_id_t> ids = s_entityStore->GetIdsByField<String>(
-            name,
-            [](Ref<EntityInfo> entity) -> String
-            { return entity->name; });
+        if (component == nullptr || type == typeid(DataComponent))
+        {
+            NTT_ENGINE_WARN("The component {} cannot be added to the entity {}", type.name(), id);
+            return;
+        }
 
-        if (ids.size() != 1)
+        if (IsDeferring())
         {
-            return INVALID_ENTITY_ID;
+            EntityCommand command;
+            command.type = ENTITY_COMMAND_ADD_COMPONENT;
+            command.id = id;
+            command.componentType = type;
+            command.component = component;
+            RecordCommand(command);
+            return;
         }
 
-        return ids[0];
+        ApplyAddComponent(id, type, component);
     }
 
-    Ref<ComponentBase> ECSGetEntityComponent(entity_id_t id, std::type_index type)
+    void ECSRemoveComponent(entity_id_t id, std::type_index type)
     {
         PROFILE_FUNCTION();
 
-        if (!s_entityStore->Contains(id))
+        auto record = s_entityStore->Get(id);
+
+        if (record == nullptr || record->deleted)
         {
-            NTT_ENGINE_TRACE("The entity with ID {} is not existed", id);
-            return nullptr;
+            NTT_ENGINE_WARN("The entity with ID {} is not existed", id);
+            return;
         }
 
-        auto entityInfo = s_entityStore->Get(id);
+        if (type == typeid(DataComponent))
+        {
+            NTT_ENGINE_WARN("The DataComponent cannot be removed from the entity {}", id);
+            return;
+        }
 
-        if (!entityInfo->components.Contains(type))
+        if (s_archetypes[record->archetype]->ColumnOf(type) < 0)
         {
             NTT_ENGINE_TRACE("The component with type {} is not existed in the entity",
                              type.name());
-            return nullptr;
+            return;
+        }
+
+        if (IsDeferring())
+        {
+            EntityCommand command;
+            command.type = ENTITY_COMMAND_REMOVE_COMPONENT;
+            command.id = id;
+            command.componentType = type;
+            RecordCommand(command);
+            return;
         }
 
-        return entityInfo->components[type];
+        ApplyRemoveComponent(id, type);
     }
 
-    void ECSSetComponentActive(entity_id_t id, std::type_index type, b8 active)
+    void ECSDeleteEntity(entity_id_t id)
     {
-        PROFILE_FUNCTION();
+        if (id == INVALID_ENTITY_ID)
+        {
+            return;
+        }
 
-        if (!s_entityStore->Contains(id))
+        if (!IsDeferring())
         {
-            NTT_ENGINE_TRACE("The entity with ID {} is not existed", id);
+            InternalEntityDelete(id);
             return;
         }
 
-        auto entityInfo = s_entityStore->Get(id);
+        // Delay delete the entity until the end of the frame (ECSUpdate)
+        std::lock_guard<std::mutex> lock(s_commandsMutex);
+
+        auto record = s_entityStore->Get(id);
 
-        if (!entityInfo->components.Contains(type))
+        if (record == nullptr || record->deleted)
         {
-            NTT_ENGINE_TRACE("The component with type {} is not existed in the entity",
-                             type.name());
             return;
         }
 
-        auto component = entityInfo->components[type];
-        component->active = active;
+        record->deleted = TRUE;
 
-        auto availableSystems = s_systemsStore->GetAvailableIds();
-        for (auto systemId : availableSystems)
+        EntityCommand command;
+        command.type = ENTITY_COMMAND_DELETE;
+        command.id = id;
+        s_commands.push_back(command);
+    }
+
+    void ECSUpdate(f32 delta)
+    {
+        PROFILE_FUNCTION();
+
+        if (s_stagesDirty)
         {
-            auto system = s_systemsStore->Get(systemId);
+            BuildStages();
+        }
 
-            if (!system->componentTypes.Contains(type))
-            {
-                continue;
-            }
+        auto frameStart = std::chrono::steady_clock::now();
+        u32 fixedSteps = 0;
 
-            if (active)
-            {
-                if (system->entities.Contains(id))
-                {
-                    continue;
-                }
+        if (s_fixedStepTime <= 0.0f)
+        {
+            UpdateStages(delta, UPDATE_PASS_ALL);
+        }
+        else
+        {
+            UpdateStages(delta, UPDATE_PASS_BEFORE_FIXED);
 
-                if (IsEntityInSystem(systemId, id))
-                {
-                    system->entities.push_back(id);
-                    system->entities.Sorted();
-                }
+            s_fixedStepAccumulator += delta;
+            fixedSteps = static_cast<u32>(s_fixedStepAccumulator / s_fixedStepTime);
+
+            if (fixedSteps > s_maxFixedSteps)
+            {
+                NTT_ENGINE_TRACE("The simulation is behind {} steps, {} steps are dropped",
+                                 fixedSteps, fixedSteps - s_maxFixedSteps);
+                fixedSteps = s_maxFixedSteps;
+                s_fixedStepAccumulator = std::fmod(s_fixedStepAccumulator, s_fixedStepTime) +
+                                         fixedSteps * s_fixedStepTime;
             }
-            else
+
+            for (u32 i = 0; i < fixedSteps; i++)
             {
-                if (system->entities.Contains(id))
-                {
-                    system->entities.RemoveItem(id);
-                }
+                s_fixedStepIndex++;
+                UpdateStages(s_fixedStepTime, UPDATE_PASS_FIXED);
+                s_fixedStepAccumulator -= s_fixedStepTime;
             }
+
+            UpdateStages(delta, UPDATE_PASS_AFTER_FIXED);
         }
+
+        s_frameStats.entitiesCount = s_entityStore->Count();
+        s_frameStats.archetypesCount = s_archetypes.size();
+        s_frameStats.createdEntities = s_createdEntities.exchange(0);
+        s_frameStats.deletedEntities = s_deletedEntities.exchange(0);
+        s_frameStats.componentStateChanges = s_componentStateChanges.exchange(0);
+        s_frameStats.componentStructureChanges = s_componentStructureChanges.exchange(0);
+        s_frameStats.fixedSteps = fixedSteps;
+        s_frameStats.updateTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                                      std::chrono::steady_clock::now() - frameStart)
+                                      .count() /
+                                  1000.0f;
     }
 
-    void ECSDeleteEntity(entity_id_t id)
+    void ECSSetFixedStep(f32 stepTime, u32 maxSteps)
     {
-        // Delay delete the entity until the end of the frame (ECSUpdate)
+        PROFILE_FUNCTION();
+        s_fixedStepTime = stepTime > 0.0f ? stepTime : 0.0f;
+        s_maxFixedSteps = maxSteps > 0 ? maxSteps : 1;
+        s_fixedStepAccumulator = 0.0f;
+    }
 
-        // if (s_deletedEntities.Contains(id))
-        // {
-        //     return;
-        // }
+    b8 ECSIsFixedStepEnabled()
+    {
+        return s_fixedStepTime > 0.0f;
+    }
 
-        // s_deletedEntities.push_back(id);
-        if (id == INVALID_ENTITY_ID)
+    u32 ECSGetFixedStepIndex()
+    {
+        return s_fixedStepIndex;
+    }
+
+    f32 ECSGetFixedStepAlpha()
+    {
+        if (s_fixedStepTime <= 0.0f)
         {
-            return;
+            return 1.0f;
         }
 
-        InternalEntityDelete(id);
+        return std::min(s_fixedStepAccumulator / s_fixedStepTime, 1.0f);
     }
 
-    void ECSUpdate(f32 delta)
+    List<SystemStats> ECSGetSystemStats()
     {
         PROFILE_FUNCTION();
 
-        auto availableIds = s_entityStore->GetAvailableIds();
-        auto availableSystems = s_systemsStore->GetAvailableIds();
+        List<SystemStats> result;
 
-        for (auto systemId : availableSystems)
+        if (s_systemsStore == nullptr)
+        {
+            return result;
+        }
+
+        for (auto systemId : s_systemsStore->GetAvailableIds())
         {
             auto system = s_systemsStore->Get(systemId);
 
-            if (!system->active)
+            SystemStats stats = {};
+            stats.name = system->name;
+            stats.active = system->active;
+            stats.entitiesCount = system->lastEntitiesCount;
+            stats.updatesCount = system->timesCount;
+
+            if (system->timesCount > 0)
             {
-                continue;
+                stats.lastTime = system->times[(system->timesNext + ECS_STATS_WINDOW - 1) % ECS_STATS_WINDOW];
             }
 
-            auto entities = system->entities;
-
-            for (auto entityId : system->entities)
+            for (u32 i = 0; i < system->timesCount; i++)
             {
-                if (system->alwayUpdate)
-                {
-                    if (!s_DrawnEntities.Contains(entityId))
-                    {
-                        continue;
-                    }
-                }
-                else
-                {
-                    if (!s_UpdatedEntities.Contains(entityId))
-                    {
-                        continue;
-                    }
-                }
-
-                if (!s_entityStore->Contains(entityId))
-                {
-                    continue;
-                }
+                stats.totalTime += system->times[i];
+                stats.maxTime = std::max(stats.maxTime, system->times[i]);
+            }
 
-                try
-                {
-                    system->system->Update(delta, entityId);
-                }
-                catch (const std::exception &e)
-                {
-                    NTT_ENGINE_ERROR("Error in system: {} - System: {}", e.what(), system->name);
-                }
+            if (system->timesCount > 0)
+            {
+                stats.averageTime = stats.totalTime / system->timesCount;
             }
+
+            result.push_back(stats);
         }
 
-        // for (auto entityId : s_deletedEntities)
-        // {
-        //     InternalEntityDelete(entityId);
-        // }
+        return result;
+    }
 
-        // s_deletedEntities.clear();
+    ECSFrameStats ECSGetFrameStats()
+    {
+        return s_frameStats;
+    }
+
+    void ECSResetStats()
+    {
+        PROFILE_FUNCTION();
+
+        s_createdEntities = 0;
+        s_deletedEntities = 0;
+        s_componentStateChanges = 0;
+        s_componentStructureChanges = 0;
+        s_frameStats = {};
+
+        if (s_systemsStore == nullptr)
+        {
+            return;
+        }
+
+        for (auto systemId : s_systemsStore->GetAvailableIds())
+        {
+            auto system = s_systemsStore->Get(systemId);
+            system->timesNext = 0;
+            system->timesCount = 0;
+            system->lastEntitiesCount = 0;
+        }
     }
 
     void ECSRemoveAllEntities()
@@ -616,7 +2778,7 @@ namespace ntt
 
         for (auto entityId : availableIds)
         {
-            InternalEntityDelete(entityId);
+            ECSDeleteEntity(entityId);
         }
     }
 
@@ -647,6 +2809,11 @@ namespace ntt
             ASSERT_M(layer == nullptr, "The layer is not reset properly");
         }
 
+        s_archetypes.clear();
+        s_archetypeIds.clear();
+
+        ECSRemoveAllPrefabs();
+
         s_entityStore.reset();
         s_systemsStore.reset();
     }
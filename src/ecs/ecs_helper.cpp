@@ -7,6 +7,7 @@
 #include <NTTEngine/renderer/Hovering.hpp>
 #include <NTTEngine/application/script_system/state_component.hpp>
 #include <NTTEngine/physics/collision.hpp>
+#include <NTTEngine/core/logging/logging.hpp>
 
 namespace ntt
 {
@@ -16,56 +17,56 @@ namespace ntt
 
         if (json.Contains<JSON>("Geometry"))
         {
-            Ref<Geometry> geometry = CreateRef<Geometry>();
+            Ref<Geometry> geometry = CreatePooledRef<Geometry>();
             geometry->FromJSON(json.Get<JSON>("Geometry"));
             components[typeid(Geometry)] = geometry;
         }
 
         if (json.Contains<JSON>("TextureComponent"))
         {
-            Ref<TextureComponent> textureComponent = CreateRef<TextureComponent>();
+            Ref<TextureComponent> textureComponent = CreatePooledRef<TextureComponent>();
             textureComponent->FromJSON(json.Get<JSON>("TextureComponent"));
             components[typeid(TextureComponent)] = textureComponent;
         }
 
         if (json.Contains<JSON>("Mass"))
         {
-            Ref<Mass> mass = CreateRef<Mass>();
+            Ref<Mass> mass = CreatePooledRef<Mass>();
             mass->FromJSON(json.Get<JSON>("Mass"));
             components[typeid(Mass)] = mass;
         }
 
         if (json.Contains<JSON>("Sprite"))
         {
-            Ref<Sprite> sprite = CreateRef<Sprite>();
+            Ref<Sprite> sprite = CreatePooledRef<Sprite>();
             sprite->FromJSON(json.Get<JSON>("Sprite"));
             components[typeid(Sprite)] = sprite;
         }
 
         if (json.Contains<JSON>("NativeScriptComponent"))
         {
-            Ref<NativeScriptComponent> nativeScriptComponent = CreateRef<NativeScriptComponent>();
+            Ref<NativeScriptComponent> nativeScriptComponent = CreatePooledRef<NativeScriptComponent>();
             nativeScriptComponent->FromJSON(json.Get<JSON>("NativeScriptComponent"));
             components[typeid(NativeScriptComponent)] = nativeScriptComponent;
         }
 
         if (json.Contains<JSON>("Hovering"))
         {
-            Ref<Hovering> hovering = CreateRef<Hovering>();
+            Ref<Hovering> hovering = CreatePooledRef<Hovering>();
             hovering->FromJSON(json.Get<JSON>("Hovering"));
             components[typeid(Hovering)] = hovering;
         }
 
         if (json.Contains<JSON>("StateComponent"))
         {
-            Ref<StateComponent> stateComponent = CreateRef<StateComponent>();
+            Ref<StateComponent> stateComponent = CreatePooledRef<StateComponent>();
             stateComponent->FromJSON(json.Get<JSON>("StateComponent"));
             components[typeid(StateComponent)] = stateComponent;
         }
 
         if (json.Contains<JSON>("Collision"))
         {
-            Ref<Collision> collision = CreateRef<Collision>();
+            Ref<Collision> collision = CreatePooledRef<Collision>();
             collision->FromJSON(json.Get<JSON>("Collision"));
             components[typeid(Collision)] = collision;
         }
@@ -84,4 +85,26 @@ namespace ntt
 
         return json;
     }
+
+    Dictionary<std::type_index, Ref<ComponentBase>> ECS_Clone(
+        const Dictionary<std::type_index, Ref<ComponentBase>> &components)
+    {
+        Dictionary<std::type_index, Ref<ComponentBase>> clonedComponents;
+
+        for (auto &component : components)
+        {
+            auto cloned = component.second->Clone();
+
+            if (cloned == nullptr)
+            {
+                NTT_ENGINE_WARN("The component {} cannot be cloned",
+                                component.second->GetName());
+                continue;
+            }
+
+            clonedComponents[component.first] = cloned;
+        }
+
+        return clonedComponents;
+    }
 } // namespace ntt
@@ -0,0 +1,81 @@
+#include <NTTEngine/ecs/prefab.hpp>
+#include <NTTEngine/ecs/ecs.hpp>
+#include <NTTEngine/ecs/ecs_helper.hpp>
+#include <NTTEngine/core/logging/logging.hpp>
+#include <NTTEngine/core/profiling.hpp>
+
+namespace ntt
+{
+    namespace
+    {
+        Dictionary<String, Dictionary<std::type_index, Ref<ComponentBase>>> s_prefabs;
+    } // namespace
+
+    void ECSRegisterPrefab(const String &name,
+                           const Dictionary<std::type_index, Ref<ComponentBase>> &components)
+    {
+        PROFILE_FUNCTION();
+
+        s_prefabs[name] = ECS_Clone(components);
+    }
+
+    void ECSRegisterPrefab(const String &name, const JSON &components)
+    {
+        PROFILE_FUNCTION();
+
+        // the parsed components are not used anywhere else, so no clone is needed
+        s_prefabs[name] = ECS_From(components);
+    }
+
+    b8 ECSHasPrefab(const String &name)
+    {
+        return s_prefabs.Contains(name);
+    }
+
+    List<entity_id_t> ECSInstantiatePrefab(const String &name, u32 count)
+    {
+        PROFILE_FUNCTION();
+
+        auto it = s_prefabs.find(name);
+
+        if (it == s_prefabs.end())
+        {
+            NTT_ENGINE_WARN("The prefab {} is not found", name);
+            return {};
+        }
+
+        const auto &prototype = it->second;
+
+        List<Ref<EntityInfo>> entities;
+        entities.reserve(count);
+
+        for (u32 i = 0; i < count; i++)
+        {
+            auto entity = CreateRef<EntityInfo>();
+            entity->name = name;
+
+            for (auto &component : prototype)
+            {
+                entity->components[component.first] = component.second->Clone();
+            }
+
+            entities.push_back(entity);
+        }
+
+        return ECSCreateEntities(entities);
+    }
+
+    void ECSRemovePrefab(const String &name)
+    {
+        PROFILE_FUNCTION();
+
+        s_prefabs.erase(name);
+    }
+
+    void ECSRemoveAllPrefabs()
+    {
+        PROFILE_FUNCTION();
+
+        s_prefabs.clear();
+    }
+} // namespace ntt
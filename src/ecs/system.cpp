@@ -0,0 +1,30 @@
+#include <NTTEngine/ecs/system.hpp>
+#include <NTTEngine/ecs/ecs.hpp>
+#include <NTTEngine/core/logging/logging.hpp>
+#include <NTTEngine/core/profiling.hpp>
+
+namespace ntt
+{
+    void System::UpdateBatch(f32 delta, Span<const entity_id_t> ids)
+    {
+        PROFILE_FUNCTION();
+
+        for (auto id : ids)
+        {
+            // the previous entities of the batch can delete this entity
+            if (!ECSIsEntityValid(id))
+            {
+                continue;
+            }
+
+            try
+            {
+                Update(delta, id);
+            }
+            catch (const std::exception &e)
+            {
+                NTT_ENGINE_ERROR("Error in system: {} - Entity: {}", e.what(), id);
+            }
+        }
+    }
+} // namespace ntt
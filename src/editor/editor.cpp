@@ -53,6 +53,7 @@ namespace ntt
         Ref<ProjectInfo> s_project;
         Ref<EditorConfig> s_config;
         Ref<SceneInfo> s_scene;
+        Ref<WorldSnapshot> s_playSnapshot; ///< The scene when the game is started
 
         Ref<EditorFileDialog> s_newProjectDialog;
         Ref<EditorFileDialog> s_openProjectDialog;
@@ -63,6 +64,7 @@ namespace ntt
         Ref<NewProjectWindow> s_newProjectWindow;
         Ref<ViewportWindow> s_viewportWindow;
         Ref<LogWindow> s_logWindow;
+        Ref<StatsWindow> s_statsWindow;
         Ref<ResourceWindow> s_resourceWindow;
         Ref<NewSceneWindow> s_newSceneWindow;
         Ref<SceneWindow> s_sceneWindow;
@@ -170,6 +172,7 @@ namespace ntt
             }
 
             s_isRunning = TRUE;
+            s_playSnapshot = ECSSnapshot({GAME_LAYER});
             ECSLayerMakeVisible(GAME_LAYER);
             ImGui::SetWindowFocus("Viewport");
         }
@@ -190,9 +193,20 @@ namespace ntt
             s_isRunning = FALSE;
             ECSLayerMakeVisible(EDITOR_LAYER);
             // s_scene->RemoveAllEntities();
-            ECS_ClearLayer(GAME_LAYER);
             ECSBeginLayer(GAME_LAYER);
-            s_scene->ReloadEntities();
+
+            // the scene is restored as it was when the game started rather
+            //      than being parsed again
+            if (s_playSnapshot != nullptr)
+            {
+                s_scene->RestoreEntities(s_playSnapshot);
+                s_playSnapshot.reset();
+            }
+            else
+            {
+                ECS_ClearLayer(GAME_LAYER);
+                s_scene->ReloadEntities();
+            }
         }
 
         void OnSaveProject(event_code_t code, void *sender, const EventContext &context)
@@ -483,6 +497,10 @@ namespace ntt
         s_normalWindows.push_back(s_logWindow);
         s_reloadWindows.push_back(s_logWindow);
 
+        s_statsWindow = CreateRef<StatsWindow>();
+        s_openClosableWindows.push_back(s_statsWindow);
+        s_normalWindows.push_back(s_statsWindow);
+
         s_resourceWindow = CreateRef<ResourceWindow>(s_project, s_config, s_scene);
         s_openClosableWindows.push_back(s_resourceWindow);
         s_normalWindows.push_back(s_resourceWindow);
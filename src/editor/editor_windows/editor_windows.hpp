@@ -1,6 +1,7 @@
 #pragma once
 
 #include "log_window/log_window.hpp"
+#include "stats_window/stats_window.hpp"
 #include "new_project/new_project.hpp"
 #include "viewport/viewport_window.hpp"
 #include "setting/setting.hpp"
@@ -139,6 +139,12 @@ namespace ntt
                         m_impl->entity = ECSGetEntity(ECSGetEntityByName(entityName));
                     },
                     &m_impl->editorData);
+
+                // the components are edited through the kept references
+                for (auto &pair : m_impl->entity->components)
+                {
+                    ECSMarkComponentChanged(pair.second->entity_id, pair.first);
+                }
             }
         }
         ImGui::End();
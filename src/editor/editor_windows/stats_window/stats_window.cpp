@@ -0,0 +1,127 @@
+#include "stats_window.hpp"
+#include <NTTEngine/ecs/ecs.hpp>
+#include <NTTEngine/renderer/GraphicInterface.hpp>
+#include <NTTEngine/core/profiling.hpp>
+#include "imgui.h"
+#include <algorithm>
+
+namespace ntt
+{
+    class StatsWindow::Impl
+    {
+    public:
+        b8 sortByTime = TRUE;
+    };
+
+    StatsWindow::StatsWindow()
+        : OpenClosableWindow("Stats"), m_impl(CreateScope<Impl>())
+    {
+        PROFILE_FUNCTION();
+    }
+
+    StatsWindow::~StatsWindow()
+    {
+        PROFILE_FUNCTION();
+    }
+
+    void StatsWindow::InitImpl()
+    {
+        PROFILE_FUNCTION();
+    }
+
+    void StatsWindow::UpdateImpl(b8 *p_open, ImGuiWindowFlags flags)
+    {
+        PROFILE_FUNCTION();
+        if (ImGui::Begin("Stats", p_open))
+        {
+            auto frame = ECSGetFrameStats();
+
+            ImGui::Text("ECS update: %.3f ms", frame.updateTime);
+            ImGui::Text("Fixed steps: %u", frame.fixedSteps);
+            ImGui::Text("Entities: %u - Archetypes: %u", frame.entitiesCount, frame.archetypesCount);
+            ImGui::Text("Created: %u - Deleted: %u", frame.createdEntities, frame.deletedEntities);
+            ImGui::Text("Components on/off: %u - added/removed: %u",
+                        frame.componentStateChanges,
+                        frame.componentStructureChanges);
+
+            auto renderer = GetRendererStats();
+
+            ImGui::Text("Draw commands: %u - Draw calls: %u",
+                        renderer.drawCommands,
+                        renderer.drawCalls);
+            ImGui::Text("Texture batches: %u - Texture switches: %u",
+                        renderer.textureBatches,
+                        renderer.textureSwitches);
+            ImGui::Text("Culled commands: %u", renderer.culledCommands);
+
+            ImGui::Checkbox("Sort by time", &m_impl->sortByTime);
+            ImGui::SameLine();
+
+            if (ImGui::Button("Reset"))
+            {
+                ECSResetStats();
+            }
+
+            ImGui::Separator();
+
+            auto systems = ECSGetSystemStats();
+
+            if (m_impl->sortByTime)
+            {
+                std::sort(systems.begin(), systems.end(),
+                          [](const SystemStats &a, const SystemStats &b)
+                          { return a.averageTime > b.averageTime; });
+            }
+
+            if (ImGui::BeginTable("systems", 6,
+                                  ImGuiTableFlags_Borders |
+                                      ImGuiTableFlags_RowBg |
+                                      ImGuiTableFlags_Resizable |
+                                      ImGuiTableFlags_ScrollY))
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("System");
+                ImGui::TableSetupColumn("Entities");
+                ImGui::TableSetupColumn("Last (ms)");
+                ImGui::TableSetupColumn("Avg (ms)");
+                ImGui::TableSetupColumn("Max (ms)");
+                ImGui::TableSetupColumn("Total (ms)");
+                ImGui::TableHeadersRow();
+
+                for (auto &system : systems)
+                {
+                    ImGui::TableNextRow();
+
+                    ImGui::TableNextColumn();
+                    if (system.active)
+                    {
+                        ImGui::TextUnformatted(system.name.RawString().c_str());
+                    }
+                    else
+                    {
+                        ImGui::TextDisabled("%s", system.name.RawString().c_str());
+                    }
+
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", system.entitiesCount);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", system.lastTime);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", system.averageTime);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", system.maxTime);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", system.totalTime);
+                }
+
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+    }
+
+    void StatsWindow::ShutdownImpl()
+    {
+        PROFILE_FUNCTION();
+    }
+} // namespace ntt
@@ -0,0 +1,27 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/core/memory.hpp>
+#include <NTTEngine/editor/OpenClosableWindow.hpp>
+
+namespace ntt
+{
+    /**
+     * Show the timings of all registered systems and the structural changes
+     *      of the ECS in the last frame (see ECSGetSystemStats)
+     */
+    class StatsWindow : public OpenClosableWindow
+    {
+    public:
+        StatsWindow();
+        ~StatsWindow() override;
+
+    protected:
+        void InitImpl() override;
+        void UpdateImpl(b8 *p_open, ImGuiWindowFlags flags) override;
+        void ShutdownImpl() override;
+
+    private:
+        class Impl;
+        Scope<Impl> m_impl;
+    };
+} // namespace ntt
@@ -27,8 +27,44 @@ namespace ntt
             Ref<EntityInfo> entityInfo = CreateRef<EntityInfo>();
             entityInfo->FromJSON(entity);
             entities.push_back(entityInfo);
+        }
+
+        m_entityIDs = ECSCreateEntities(entities);
+
+        TriggerEvent(NTT_EDITOR_RELOAD_SCENE);
+    }
 
-            m_entityIDs.push_back(ECSCreateEntity(entityInfo->name, entityInfo->components));
+    void SceneInfo::RestoreEntities(Ref<WorldSnapshot> snapshot)
+    {
+        PROFILE_FUNCTION();
+        auto restoredIds = ECSRestore(snapshot);
+
+        Dictionary<entity_id_t, entity_id_t> ids;
+        for (u32 i = 0; i < restoredIds.size(); i++)
+        {
+            ids[snapshot->entities[i].id] = restoredIds[i];
+        }
+
+        // the entity infos must refer to the restored components so the
+        //      editor changes are still saved
+        for (u32 i = 0; i < entities.size() && i < m_entityIDs.size(); i++)
+        {
+            if (!ids.Contains(m_entityIDs[i]))
+            {
+                continue;
+            }
+
+            m_entityIDs[i] = ids[m_entityIDs[i]];
+
+            for (auto &pair : entities[i]->components)
+            {
+                auto component = ECSGetEntityComponent(m_entityIDs[i], pair.first, FALSE);
+
+                if (component != nullptr)
+                {
+                    pair.second = component;
+                }
+            }
         }
 
         TriggerEvent(NTT_EDITOR_RELOAD_SCENE);
@@ -92,7 +128,7 @@ namespace ntt
         {
             if (entityInfo->name == entityName)
             {
-                entity->components = entityInfo->components;
+                entity->components = ECS_Clone(entityInfo->components);
                 entities.push_back(entity);
                 break;
             }
@@ -9,6 +9,11 @@
 
 namespace ntt
 {
+    Ref<ComponentBase> Collision::Clone() const
+    {
+        return CreatePooledRef<Collision>(*this);
+    }
+
     String Collision::GetName() const
     {
         return "Collision";
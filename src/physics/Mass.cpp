@@ -9,6 +9,11 @@ namespace ntt
         acc_y = forceY / mass;
     }
 
+    Ref<ComponentBase> Mass::Clone() const
+    {
+        return CreatePooledRef<Mass>(*this);
+    }
+
     String Mass::GetName() const
     {
         return "Mass";
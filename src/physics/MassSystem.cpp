@@ -3,6 +3,7 @@
 #include <NTTEngine/renderer/Geometry.hpp>
 #include <NTTEngine/core/profiling.hpp>
 
+/// The velocity and the acceleration are measured per 10 milliseconds
 #define TIME_FACTOR (1.0f / 10)
 
 namespace ntt
@@ -37,16 +38,26 @@ namespace ntt
     }
 
     void MassSystem::Update(f32 delta, entity_id_t id)
+    {
+        UpdateBatch(delta, Span<const entity_id_t>(&id, 1));
+    }
+
+    void MassSystem::UpdateBatch(f32 delta, Span<const entity_id_t> ids)
     {
         PROFILE_FUNCTION();
-        auto mass = ECS_GET_COMPONENT(id, Mass);
-        auto geo = ECS_GET_COMPONENT(id, Geometry);
+        const f32 step = delta * TIME_FACTOR;
 
-        mass->velocity_x += mass->acc_x * delta * TIME_FACTOR;
-        mass->velocity_y += mass->acc_y * delta * TIME_FACTOR;
+        // the components are walked in their columns, the deleted entities are skipped
+        ECSQuery<Mass, Geometry>().ForEach(
+            ids,
+            [step](entity_id_t, Mass &mass, Geometry &geo)
+            {
+                mass.velocity_x += mass.acc_x * step;
+                mass.velocity_y += mass.acc_y * step;
 
-        geo->pos.x += mass->velocity_x * delta * TIME_FACTOR;
-        geo->pos.y += mass->velocity_y * delta * TIME_FACTOR;
+                geo.pos.x += mass.velocity_x * step;
+                geo.pos.y += mass.velocity_y * step;
+            });
     }
 
     void MassSystem::ShutdownEntity(entity_id_t id)
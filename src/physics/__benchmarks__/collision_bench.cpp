@@ -0,0 +1,43 @@
+#include <NTTEngine/dev/benchmark.hpp>
+
+#include <NTTEngine/ecs/ecs.hpp>
+#include <NTTEngine/application/event_system/event_system.hpp>
+#include <NTTEngine/renderer/Geometry.hpp>
+#include <NTTEngine/physics/collision.hpp>
+#include <NTTEngine/physics/collision_system.hpp>
+
+using namespace ntt;
+
+NTT_BENCHMARK(CollisionBodies, 100, 1000)
+{
+    EventInit();
+    ECSInit();
+
+    ECSRegister(
+        COLLISION_NAME,
+        CreateRef<CollisionSystem>(),
+        {typeid(Geometry), typeid(Collision)});
+
+    ECSBeginLayer(GAME_LAYER);
+    ECSLayerMakeVisible(GAME_LAYER);
+
+    // the bodies are placed on a grid where each one overlaps its neighbours
+    for (u32 i = 0; i < bench.Argument(); i++)
+    {
+        ECSCreateEntity(
+            "body",
+            {ECS_CREATE_COMPONENT(Geometry,
+                                  static_cast<f32>(i % 32) * 4,
+                                  static_cast<f32>(i / 32) * 4,
+                                  5.0f,
+                                  5.0f),
+             ECS_CREATE_COMPONENT(Collision)});
+    }
+
+    bench.SetItemsCount(bench.Argument());
+    bench.Run([&]()
+              { ECSUpdate(16.0f); });
+
+    ECSShutdown();
+    EventShutdown();
+}
@@ -41,7 +41,7 @@ namespace ntt
     void CollisionSystem::Update(f32 delta, entity_id_t entity_id)
     {
         PROFILE_FUNCTION();
-        auto collisionComponent = ECS_GET_COMPONENT(entity_id, Collision);
+        auto collisionComponent = ECS_READ_COMPONENT(entity_id, Collision);
 
         if (collisionComponent->callback == nullptr)
         {
@@ -49,7 +49,7 @@ namespace ntt
         }
 
         List<entity_id_t> colliedEntities;
-        auto geo = ECS_GET_COMPONENT(entity_id, Geometry);
+        auto geo = ECS_READ_COMPONENT(entity_id, Geometry);
         auto halfWidth = geo->size.width / 2;
         auto halfHeight = geo->size.height / 2;
 
@@ -74,7 +74,7 @@ namespace ntt
 
         for (auto other : others)
         {
-            auto otherGeo = ECS_GET_COMPONENT(other, Geometry);
+            auto otherGeo = ECS_READ_COMPONENT(other, Geometry);
 
             auto halfOtherWidth = otherGeo->size.width / 2;
             auto halfOtherHeight = otherGeo->size.height / 2;
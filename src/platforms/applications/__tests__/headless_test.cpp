@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <NTTEngine/platforms/application.hpp>
+
+using namespace ntt;
+
+TEST(HeadlessTest, OptionsAreDisabledByDefault)
+{
+    char program[] = "game";
+    char *argv[] = {program};
+
+    auto options = ParseHeadlessOptions(1, argv);
+
+    EXPECT_FALSE(options.enabled);
+    EXPECT_EQ(options.fixedDelta, 0.0f);
+    EXPECT_EQ(options.maxFrames, 0);
+}
+
+TEST(HeadlessTest, ArgumentsOverrideConfiguration)
+{
+    JSON config(R"({"headless": true, "fixedDelta": 10, "maxFrames": 100})");
+
+    char program[] = "game";
+    char frames[] = "--frames=5";
+    char *argv[] = {program, frames};
+
+    auto options = ParseHeadlessOptions(2, argv, config);
+    EXPECT_TRUE(options.enabled);
+    EXPECT_FLOAT_EQ(options.fixedDelta, 10.0f);
+    EXPECT_EQ(options.maxFrames, 5);
+
+    char headless[] = "--headless";
+    char fixedDelta[] = "--fixed-delta=16.5";
+    char unknown[] = "--frames-per-second=60";
+    char *otherArgv[] = {program, headless, fixedDelta, unknown};
+
+    options = ParseHeadlessOptions(4, otherArgv);
+    EXPECT_TRUE(options.enabled);
+    EXPECT_FLOAT_EQ(options.fixedDelta, 16.5f);
+    EXPECT_EQ(options.maxFrames, 0);
+}
@@ -6,6 +6,7 @@
 #include <NTTEngine/ecs/ecs.hpp>
 #include <NTTEngine/core/time.hpp>
 #include <NTTEngine/core/profiling.hpp>
+#include <NTTEngine/core/thread_pool.hpp>
 #include <NTTEngine/application/input_system/input_system.hpp>
 #include <NTTEngine/structures/list.hpp>
 
@@ -43,8 +44,25 @@ namespace ntt
         JSON s_config("{}");
         b8 s_editor = FALSE;
 
+        HeadlessOptions s_headless;
+        u32 s_frames = 0;
+
+        /**
+         * The world right after the first Begin phrase, the application is
+         *      reset by restoring it rather than running the phrase again
+         */
+        Ref<WorldSnapshot> s_startSnapshot;
+
         void ApplicationReload()
         {
+            if (s_startSnapshot != nullptr)
+            {
+                ECSRestore(s_startSnapshot);
+                ECSBeginLayer(GAME_LAYER);
+                ECSLayerMakeVisible(GAME_LAYER);
+                return;
+            }
+
             ECSRemoveAllEntities();
             // ResourceStart();
             ECSBeginLayer(GAME_LAYER);
@@ -59,11 +77,17 @@ namespace ntt
                          const char *title,
                          const Phrases &phrases,
                          List<String> sceneNames,
-                         b8 editor)
+                         b8 editor,
+                         const HeadlessOptions &headless)
     {
         PROFILE_FUNCTION();
         s_phrases = phrases;
-        s_editor = editor;
+        s_headless = headless;
+        s_frames = 0;
+
+        // the editor needs the window for drawing the ImGui
+        s_editor = editor && !headless.enabled;
+        editor = s_editor;
 
         auto handlers = List<Ref<Handler>>{
             CreateRef<ConsoleHandler>(),
@@ -82,13 +106,13 @@ namespace ntt
         s_windowSize.width = static_cast<ntt_size_t>(screenWidth);
         s_windowSize.height = static_cast<ntt_size_t>(screenHeight);
 
-        RendererInit();
+        RendererInit(s_headless.enabled);
         ResourceInit(editor);
-        InputInit(FALSE, editor);
+        InputInit(s_headless.enabled, editor);
 
         // TODO: Refactor this
         SetTraceLogLevel(LOG_NONE);
-        AudioInit();
+        AudioInit(s_headless.enabled);
 
         String resourceConfig = ReadFile(RelativePath("assets/configs/resources.json"));
         if (resourceConfig == "")
@@ -113,57 +137,16 @@ namespace ntt
 
         // ResourceStart();
 
+        ThreadPoolInit();
         ECSInit();
 
-        // Parent system must be front of the render system for
-        //      child entity's position to be updated before rendering
-        ECSRegister(
-            "Parent System",
-            CreateRef<ParentSystem>(),
-            {typeid(Parent)},
-            TRUE);
-
-        ECSRegister(
-            "Render System",
-            CreateRef<RenderSystem>(),
-            {typeid(Geometry)},
-            TRUE);
-
-        ECSRegister(
-            "Editor System",
-            CreateRef<EditorSystem>(),
-            {typeid(Geometry)},
-            TRUE);
-
-        ECSRegister(
-            "Native Script System",
-            CreateRef<ScriptSystem>(),
-            {typeid(NativeScriptComponent)});
-
-        ECSRegister(
-            "State System",
-            CreateRef<StateSystem>(),
-            {typeid(StateComponent)});
-
-        ECSRegister(
-            "Collision System",
-            CreateRef<CollisionSystem>(),
-            {typeid(Geometry), typeid(Collision)});
-
-        ECSRegister(
-            "Hovering System",
-            CreateRef<MouseHoveringSystem>(),
-            {typeid(Hovering), typeid(Geometry)});
-
-        ECSRegister(
-            "Mass System",
-            CreateRef<MassSystem>(),
-            {typeid(Mass), typeid(Geometry)});
-
-        ECSRegister(
-            "Sprite Render System",
-            CreateRef<SpriteRenderSystem>(),
-            {typeid(Sprite), typeid(TextureComponent)});
+        RegisterEngineSystems(s_editor);
+
+        // the physics is simulated at a constant rate ("tickRate" per second),
+        //      0 updates it once per frame with the frame delta
+        f32 tickRate = s_config.Get<f32>("tickRate", 60.0f);
+        ECSSetFixedStep(tickRate > 0 ? 1000.0f / tickRate : 0.0f,
+                        s_config.Get<u32>("maxFixedSteps", ECS_MAX_FIXED_STEPS));
 
         /// Setup 3 layers in the predefined order GAME_LAYER -> UI_LAYER -> EDITOR_LAYER
         ///     then now the user's code will not affect the order of the layer
@@ -176,26 +159,34 @@ namespace ntt
 
         s_timer.Reset();
 
-        // TODO: Refactor this
-        if (s_editor)
+        if (s_headless.enabled)
         {
-            SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+            NTT_ENGINE_INFO("The application runs in the headless mode.");
         }
+        else
+        {
+            // TODO: Refactor this
+            if (s_editor)
+            {
+                SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+            }
 
-        CREATE_WINDOW(screenWidth, screenHeight, title);
+            CREATE_WINDOW(screenWidth, screenHeight, title);
 
-        if (s_editor)
-        {
-            MaximizeWindow();
-        }
+            if (s_editor)
+            {
+                MaximizeWindow();
+            }
 
-        EditorInit("");
+            EditorInit("");
+        }
 
         // ResourceStart();
         ECSBeginLayer(GAME_LAYER);
         s_phrases.Begin();
         ECSBeginLayer(GAME_LAYER);
         ECSLayerMakeVisible(GAME_LAYER);
+        s_startSnapshot = ECSSnapshot({GAME_LAYER, UI_LAYER});
 
         if (editor)
         {
@@ -230,12 +221,46 @@ namespace ntt
         return s_config;
     }
 
+    b8 HeadlessStep(const HeadlessOptions &options,
+                    u32 &frames,
+                    f32 elapsed,
+                    const std::function<void(f32)> &mainLoop)
+    {
+        PROFILE_FUNCTION();
+        f32 delta = options.fixedDelta > 0 ? options.fixedDelta : elapsed;
+
+        InputUpdate(delta);
+        AudioUpdate(delta);
+
+        if (mainLoop)
+        {
+            mainLoop(delta);
+        }
+
+        ECSUpdate(delta);
+        GraphicUpdate();
+
+        frames++;
+
+        EventContext context;
+        context.f32_data[0] = elapsed > 0 ? 1000.0f / elapsed : 0.0f; ///< FPS of the simulation
+        TriggerEvent(NTT_END_FRAME, nullptr, context);
+
+        return options.maxFrames == 0 || frames < options.maxFrames;
+    }
+
     void ApplicationUpdate(b8 &running)
     {
         PROFILE_FUNCTION();
         auto delta = static_cast<f32>(s_timer.GetMilliseconds());
         s_timer.Reset();
 
+        if (s_headless.enabled)
+        {
+            running = HeadlessStep(s_headless, s_frames, delta, s_phrases.MainLoop);
+            return;
+        }
+
         InputUpdate(delta);
         AudioUpdate(delta);
 
@@ -265,6 +290,11 @@ namespace ntt
         TriggerEvent(NTT_END_FRAME, nullptr, context);
     }
 
+    b8 IsHeadless()
+    {
+        return s_headless.enabled;
+    }
+
     Size &GetWindowSize()
     {
         return s_windowSize;
@@ -306,15 +336,26 @@ namespace ntt
     {
         PROFILE_FUNCTION();
         s_phrases.Close();
-        EditorShutdown();
+
+        if (!s_headless.enabled)
+        {
+            EditorShutdown();
+        }
+
+        s_startSnapshot.reset();
         ECSShutdown();
+        ThreadPoolShutdown();
 
         AudioShutdown();
         InputShutdown();
         ResourceShutdown();
         RendererShutdown();
 
-        CLOSE_WINDOW();
+        if (!s_headless.enabled)
+        {
+            CLOSE_WINDOW();
+        }
+
         NTT_ENGINE_INFO("The application is closed.");
 
         ScriptStoreShutdown();
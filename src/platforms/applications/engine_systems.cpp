@@ -0,0 +1,92 @@
+#include <NTTEngine/platforms/application.hpp>
+#include <NTTEngine/core/memory.hpp>
+#include <NTTEngine/core/profiling.hpp>
+#include <NTTEngine/ecs/ecs.hpp>
+
+#include <NTTEngine/renderer/RenderSystem.hpp>
+#include <NTTEngine/renderer/ParentSystem.hpp>
+#include <NTTEngine/renderer/MouseHoveringSystem.hpp>
+
+#include <NTTEngine/physics/physics_dev.hpp>
+#include <NTTEngine/physics/collision.hpp>
+#include <NTTEngine/physics/collision_system.hpp>
+#include <NTTEngine/physics/MassSystem.hpp>
+
+#include <NTTEngine/editor/editor_system.hpp>
+
+#include <NTTEngine/application/script_system/native_script_system.hpp>
+#include <NTTEngine/application/script_system/script_component.hpp>
+#include <NTTEngine/application/script_system/state_system.hpp>
+#include <NTTEngine/application/script_system/state_component.hpp>
+
+namespace ntt
+{
+    void RegisterEngineSystems(b8 editor)
+    {
+        PROFILE_FUNCTION();
+
+        // Parent system must be front of the render system for
+        //      child entity's position to be updated before rendering
+        ECSRegister(
+            "Parent System",
+            CreateRef<ParentSystem>(),
+            {typeid(Parent)},
+            TRUE,
+            SystemAccess({typeid(Parent), typeid(Geometry)}, {typeid(Geometry)}));
+
+        ECSRegister(
+            "Render System",
+            CreateRef<RenderSystem>(editor),
+            {typeid(Geometry)},
+            TRUE);
+
+        if (editor)
+        {
+            ECSRegister(
+                "Editor System",
+                CreateRef<EditorSystem>(),
+                {typeid(Geometry)},
+                TRUE);
+        }
+
+        ECSRegister(
+            "Native Script System",
+            CreateRef<ScriptSystem>(),
+            {typeid(NativeScriptComponent)});
+
+        ECSRegister(
+            "State System",
+            CreateRef<StateSystem>(),
+            {typeid(StateComponent)});
+
+        // the fixed steps (collision and mass) are run at this place, after
+        //      the hierarchy and the scripts of the frame are updated
+        ECSRegister(
+            COLLISION_NAME,
+            CreateRef<CollisionSystem>(),
+            {typeid(Geometry), typeid(Collision)},
+            FALSE,
+            SystemAccess(),
+            TRUE);
+
+        ECSRegister(
+            "Hovering System",
+            CreateRef<MouseHoveringSystem>(),
+            {typeid(Hovering), typeid(Geometry)});
+
+        ECSRegister(
+            "Mass System",
+            CreateRef<MassSystem>(),
+            {typeid(Mass), typeid(Geometry)},
+            FALSE,
+            SystemAccess({}, {typeid(Mass), typeid(Geometry)}, TRUE),
+            TRUE);
+
+        ECSRegister(
+            "Sprite Render System",
+            CreateRef<SpriteRenderSystem>(),
+            {typeid(Sprite), typeid(TextureComponent)},
+            FALSE,
+            SystemAccess({}, {typeid(Sprite), typeid(TextureComponent)}, TRUE));
+    }
+} // namespace ntt
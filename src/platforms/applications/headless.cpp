@@ -0,0 +1,61 @@
+#include <NTTEngine/platforms/application.hpp>
+#include <NTTEngine/core/logging/logging.hpp>
+#include <cstring>
+#include <cstdlib>
+
+namespace ntt
+{
+    namespace
+    {
+        /**
+         * Return the value of the argument "<name>=<value>", nullptr if the
+         *      argument has another name
+         */
+        const char *GetArgumentValue(const char *argument, const char *name)
+        {
+            u32 length = std::strlen(name);
+
+            if (std::strncmp(argument, name, length) != 0 || argument[length] != '=')
+            {
+                return nullptr;
+            }
+
+            return argument + length + 1;
+        }
+    } // namespace
+
+    HeadlessOptions ParseHeadlessOptions(i32 argc, char **argv, const JSON &config)
+    {
+        HeadlessOptions options;
+        options.enabled = config.Get<b8>("headless", FALSE);
+        options.fixedDelta = config.Get<f32>("fixedDelta", 0.0f);
+        options.maxFrames = config.Get<u32>("maxFrames", 0);
+
+        for (i32 i = 1; i < argc; i++)
+        {
+            const char *value = nullptr;
+
+            if (std::strcmp(argv[i], "--headless") == 0)
+            {
+                options.enabled = TRUE;
+            }
+            else if ((value = GetArgumentValue(argv[i], "--fixed-delta")) != nullptr)
+            {
+                options.fixedDelta = static_cast<f32>(std::atof(value));
+            }
+            else if ((value = GetArgumentValue(argv[i], "--frames")) != nullptr)
+            {
+                options.maxFrames = static_cast<u32>(std::strtoul(value, nullptr, 10));
+            }
+        }
+
+        if (options.fixedDelta < 0)
+        {
+            NTT_ENGINE_WARN("The fixed delta {} is negative, the real elapsed time is used",
+                            options.fixedDelta);
+            options.fixedDelta = 0.0f;
+        }
+
+        return options;
+    }
+} // namespace ntt
@@ -17,8 +17,15 @@ namespace ntt
         m_drawRectangleCalled = 0;
         m_drawRectangleProCalled = 0;
         m_drawTextureCalled = 0;
+        m_drawTextureBatchCalled = 0;
+        m_loadAtlasTextureCalled = 0;
+        m_loadTextureFromImageCalled = 0;
 
         m_drawTexts = List<String>();
+        m_drawCalls = List<String>();
+        m_drawnQuads = List<TextureQuad>();
+        m_failedPaths = List<String>();
+        m_expectedTexture = Texture2D(nullptr, 0, 0);
         s_instance = this;
     }
 
@@ -29,6 +36,12 @@ namespace ntt
 
     Texture2D FakeGraphicAPI::LoadTexture(const String &path)
     {
+        // the failed texture is marked with the negative size
+        if (m_failedPaths.Contains(path))
+        {
+            return Texture2D(nullptr, -1, -1);
+        }
+
         return m_expectedTexture;
     }
 
@@ -36,9 +49,42 @@ namespace ntt
     {
     }
 
-    b8 FakeGraphicAPI::IsLoadedSuccess(Texture2D)
+    b8 FakeGraphicAPI::IsLoadedSuccess(Texture2D texture)
+    {
+        return texture.width >= 0;
+    }
+
+    Image FakeGraphicAPI::LoadImage(const String &path)
+    {
+        if (m_failedPaths.Contains(path))
+        {
+            return Image(nullptr, 0, 0);
+        }
+
+        return Image(nullptr, m_expectedTexture.width, m_expectedTexture.height);
+    }
+
+    void FakeGraphicAPI::UnloadImage(Image)
+    {
+    }
+
+    Size FakeGraphicAPI::LoadImageSize(const String &path)
+    {
+        return Size(m_expectedTexture.width, m_expectedTexture.height);
+    }
+
+    Texture2D FakeGraphicAPI::LoadTextureFromImage(Image image)
+    {
+        m_loadTextureFromImageCalled++;
+        return Texture2D(nullptr, image.width, image.height);
+    }
+
+    Texture2D FakeGraphicAPI::LoadAtlasTexture(u32 width,
+                                               u32 height,
+                                               const List<AtlasImage> &images)
     {
-        return TRUE;
+        m_loadAtlasTextureCalled++;
+        return Texture2D(nullptr, static_cast<f32>(width), static_cast<f32>(height));
     }
 
     void FakeGraphicAPI::DrawText(
@@ -61,6 +107,7 @@ namespace ntt
     void FakeGraphicAPI::DrawRectangle(f32 x, f32 y, f32 width, f32 height, const RGBAColor &color)
     {
         m_drawRectangleCalled++;
+        m_drawCalls.push_back("rectangle");
     }
 
     void FakeGraphicAPI::DrawRectanglePro(
@@ -72,6 +119,7 @@ namespace ntt
         const RGBAColor &color)
     {
         m_drawRectangleProCalled++;
+        m_drawCalls.push_back("rectangle");
     }
 
     void FakeGraphicAPI::DrawTexture(Texture2D texture,
@@ -86,6 +134,17 @@ namespace ntt
                                      f32 rotate)
     {
         m_drawTextureCalled++;
+        m_drawCalls.push_back("texture");
+    }
+
+    void FakeGraphicAPI::DrawTextureBatch(Texture2D texture,
+                                          const TextureQuad *quads,
+                                          u32 count)
+    {
+        m_drawTextureBatchCalled++;
+        m_drawTextureCalled += count;
+        m_drawCalls.push_back("texture");
+        m_drawnQuads.insert(m_drawnQuads.end(), quads, quads + count);
     }
 
     void FakeGraphicAPI::DrawNoFillRectangle(f32 x, f32 y, f32 width, f32 height, const RGBAColor &color)
@@ -14,6 +14,14 @@ namespace ntt
         void UnloadTexture(Texture2D) override;
         b8 IsLoadedSuccess(Texture2D) override;
 
+        Image LoadImage(const String &path) override;
+        void UnloadImage(Image) override;
+        Size LoadImageSize(const String &path) override;
+        Texture2D LoadTextureFromImage(Image image) override;
+        Texture2D LoadAtlasTexture(u32 width,
+                                   u32 height,
+                                   const List<AtlasImage> &images) override;
+
         void DrawText(
             const String &text,
             f32 x,
@@ -43,6 +51,10 @@ namespace ntt
                          f32 th,
                          f32 rotate) override;
 
+        void DrawTextureBatch(Texture2D texture,
+                              const TextureQuad *quads,
+                              u32 count) override;
+
         void DrawNoFillRectangle(f32 x, f32 y, f32 width, f32 height, const RGBAColor &color) override;
         void DrawLine(f32 startX, f32 startY,
                       f32 endX, f32 endY,
@@ -52,9 +64,15 @@ namespace ntt
         u8 m_drawTextCalled;
         u8 m_drawRectangleCalled;
         u8 m_drawRectangleProCalled;
-        u8 m_drawTextureCalled;
+        u8 m_drawTextureCalled; ///< The number of the drawn textures (including the batched ones)
+        u8 m_drawTextureBatchCalled;
         List<String> m_drawTexts;
-        Texture2D m_expectedTexture;
+        List<String> m_drawCalls; ///< The kind of each rectangle/texture call in order
+        List<TextureQuad> m_drawnQuads; ///< The quads of all texture batches in order
+        u8 m_loadAtlasTextureCalled;
+        u8 m_loadTextureFromImageCalled;
+        Texture2D m_expectedTexture; ///< Also used for the size of the loaded images
+        List<String> m_failedPaths;  ///< The images and textures of these paths cannot be loaded
 
         static FakeGraphicAPI *s_instance;
 
@@ -15,6 +15,46 @@ namespace ntt
         };
     } // namespace
 
+    Position Geometry::GetDrawnPos() const
+    {
+        if (lastStep == 0 || lastStep != ECSGetFixedStepIndex())
+        {
+            return pos;
+        }
+
+        f32 alpha = ECSGetFixedStepAlpha();
+
+        return {lastPos.x + (pos.x - lastPos.x) * alpha,
+                lastPos.y + (pos.y - lastPos.y) * alpha};
+    }
+
+    f32 Geometry::GetDrawnRotation() const
+    {
+        if (lastStep == 0 || lastStep != ECSGetFixedStepIndex())
+        {
+            return rotation;
+        }
+
+        // turn through the shorter way
+        f32 diff = rotation - lastRotation;
+
+        if (diff > 180.0f)
+        {
+            diff -= 360.0f;
+        }
+        else if (diff < -180.0f)
+        {
+            diff += 360.0f;
+        }
+
+        return lastRotation + diff * ECSGetFixedStepAlpha();
+    }
+
+    Ref<ComponentBase> Geometry::Clone() const
+    {
+        return CreatePooledRef<Geometry>(*this);
+    }
+
     String Geometry::GetName() const
     {
         return "Geometry";
@@ -2,6 +2,8 @@
 #include <NTTEngine/defines.hpp>
 #include <NTTEngine/structures/color.hpp>
 #include <NTTEngine/structures/string.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <NTTEngine/structures/size.hpp>
 #include <NTTEngine/core/memory.hpp>
 
 namespace ntt
@@ -19,6 +21,49 @@ namespace ntt
             : texture(texture.texture), width(texture.width), height(texture.height) {}
     };
 
+    /**
+     * The decoded image in the memory (not uploaded to the GPU), the width
+     *      and the height are 0 if the image can not be loaded
+     */
+    struct Image
+    {
+        Ref<void> image;
+        f32 width;
+        f32 height;
+
+        Image() = default;
+        Image(Ref<void> image, f32 width, f32 height)
+            : image(image), width(width), height(height) {}
+    };
+
+    /**
+     * The image and its top-left position in an atlas page
+     */
+    struct AtlasImage
+    {
+        Image image;
+        u32 x;
+        u32 y;
+    };
+
+    /**
+     * One textured quad of a batch, the same values as the DrawTexture
+     *      parameters (the source rectangle in the texture, the destination
+     *      rectangle which is centered at (toX, toY) and the rotation)
+     */
+    struct TextureQuad
+    {
+        f32 fromX;
+        f32 fromY;
+        f32 fromWidth;
+        f32 fromHeight;
+        f32 toX;
+        f32 toY;
+        f32 toWidth;
+        f32 toHeight;
+        f32 rotate;
+    };
+
     class GraphicAPI
     {
     public:
@@ -26,6 +71,33 @@ namespace ntt
         virtual void UnloadTexture(Texture2D) = 0;
         virtual b8 IsLoadedSuccess(Texture2D) = 0;
 
+        /**
+         * Decode the image file, it's called on the worker threads (it must
+         *      not touch the GPU)
+         */
+        virtual Image LoadImage(const String &path) = 0;
+        virtual void UnloadImage(Image) = 0;
+
+        /**
+         * Read the size of the image from the file header without decoding
+         *      the pixels, 0x0 if the size can not be read
+         */
+        virtual Size LoadImageSize(const String &path) = 0;
+
+        /**
+         * Upload the decoded image to the GPU (the image is still owned by
+         *      the caller)
+         */
+        virtual Texture2D LoadTextureFromImage(Image image) = 0;
+
+        /**
+         * Create a texture with the given size and copy all images into it
+         *      (the images are still owned by the caller)
+         */
+        virtual Texture2D LoadAtlasTexture(u32 width,
+                                           u32 height,
+                                           const List<AtlasImage> &images) = 0;
+
         virtual void DrawText(
             const String &text,
             f32 x,
@@ -60,6 +132,14 @@ namespace ntt
                                  f32 th,
                                  f32 rotate) = 0;
 
+        /**
+         * Draw all the quads with the same texture, the texture is bound
+         *      once for the whole batch
+         */
+        virtual void DrawTextureBatch(Texture2D texture,
+                                      const TextureQuad *quads,
+                                      u32 count) = 0;
+
         virtual void DrawNoFillRectangle(
             f32 x,
             f32 y,
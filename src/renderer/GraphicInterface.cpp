@@ -5,7 +5,10 @@
 #include <NTTEngine/structures/dictionary.hpp>
 #include <NTTEngine/core/memory.hpp>
 #include <NTTEngine/platforms/path.hpp>
+#include <algorithm>
 #include <cstring>
+#include <type_traits>
+#include <unordered_map>
 #include <NTTEngine/dev/store.hpp>
 #include <NTTEngine/core/profiling.hpp>
 #include <NTTEngine/application/input_system/input_system.hpp>
@@ -14,9 +17,16 @@
 #include <NTTEngine/application/event_system/event_system.hpp>
 #include <NTTEngine/resources/ResourceManager.hpp>
 #include <NTTEngine/core/object.hpp>
+#include <NTTEngine/core/thread_pool.hpp>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 #include "Raylib_GraphicAPI.hpp"
 #include "Fake_GraphicAPI.hpp"
+#include "TextureAtlas.hpp"
+#include "SpatialGrid.hpp"
+#include <cmath>
 
 namespace ntt
 {
@@ -26,58 +36,185 @@ namespace ntt
 #define TOOL_TOP_OFFSET_X 20
 #define TOOL_TOP_OFFSET_Y 20
 #define MAX_PRIORITIES (LAYER_PRIORITY_RANGE * MAX_LAYERS)
+#define EMPTY_STRING_INDEX 0
+#define MAX_INTERNED_STRINGS 4096 ///< The string pool is reset when it's larger
+#define ATLAS_PAGE_SIZE 2048
+#define ATLAS_PADDING 2
+#define ATLAS_TEXTURE_KEY(page) (0x80000000u | (page)) ///< The batch key of the images in the page
+#define TEXTURE_UPLOAD_BUDGET (2048 * 2048)            ///< The pixels which are uploaded in a frame (at least one image)
+#define PLACEHOLDER_COLOR RGBAColor(128, 128, 128, 128)  ///< The color of the textures which are still loading
 
     /**
      * All the needed information for rendering the texture
      */
     struct TextureInfo : public Object
     {
-        Texture2D texture; ///< The texture which is loaded
+        Texture2D texture; ///< The texture which is loaded (the page if the image is in an atlas)
         Grid grid;         ///< The grid of the texture
         String path;       ///< The path of the texture
         f32 frameWith;     ///< The width each frame in the texture
         f32 frameHeight;   ///< The height each frame in the texture
 
+        u32 atlasPage = ATLAS_NO_PAGE; ///< The atlas page which contains the image
+        f32 x = 0;                     ///< The left of the image in the texture
+        f32 y = 0;                     ///< The top of the image in the texture
+        f32 width = 0;                 ///< The width of the image
+        f32 height = 0;                ///< The height of the image
+        b8 loaded = TRUE;              ///< FALSE until the decoded image is uploaded (a placeholder is drawn)
+        b8 failed = FALSE;             ///< The image cannot be loaded at all (nothing is drawn)
+
         TextureInfo(Texture2D texture, const String &path) : texture(texture), path(path) {}
         TextureInfo(Texture2D texture, const Grid &grid, const String &path)
             : texture(texture), grid(grid), path(path) {}
     };
 
-    struct DrawInfo
+    enum DrawCommandType : u8
+    {
+        DRAW_COMMAND_TEXTURE,
+        DRAW_COMMAND_RECTANGLE,
+        DRAW_COMMAND_TEXT,
+        DRAW_COMMAND_LINE,
+    };
+
+    /**
+     * One drawing call which is kept until GraphicUpdate, the command only
+     *      contains plain values (the texts are interned in the string pool
+     *      and referenced by their indexes), so the commands of a frame are
+     *      packed in a single buffer which is reused in the next frames.
+     */
+    struct DrawCommand
     {
         entity_id_t entity_id;
         resource_id_t texture_id;
+        u32 textureKey; ///< The textures with the same key are batched (the images of an atlas page share it)
         f32 fromX;
         f32 fromY;
         f32 fromWidth;
         f32 fromHeight;
         f32 toX;
         f32 toY;
-        f32 toWidth;
-        f32 toHeight;
+        f32 toWidth;  ///< The x position of the end point for the lines
+        f32 toHeight; ///< The y position of the end point for the lines
         f32 rotate;
-        String tooltip;
-        b8 drawText = FALSE;
-        String text;
+        u32 text;    ///< The index of the text in the string pool
+        u32 tooltip; ///< The index of the tooltip in the string pool
         u32 fontSize;
         RGBAColor color;
-        b8 drawLine = FALSE;
+        DrawCommandType type;
         u8 lineType;
-        f32 toXEnd;
-        f32 toYEnd;
+        u8 priority;
+    };
+
+    static_assert(std::is_trivially_copyable<DrawCommand>::value,
+                  "The draw commands are copied as the plain memory");
+
+    /**
+     * The texture which contains multiple images, it's unloaded when all
+     *      of its images are unloaded
+     */
+    struct AtlasPage
+    {
+        Texture2D texture;
+        u32 texturesCount; ///< The loaded textures which use the page
+        u32 width;
+        u32 height;
+
+        b8 loaded;               ///< FALSE until all images are decoded and the page is uploaded
+        u32 imagesCount;         ///< The images which are packed in the page
+        List<AtlasImage> images; ///< The decoded images which wait for the rest of the page
+    };
+
+    /**
+     * The rectangle in the world space
+     */
+    struct ViewRect
+    {
+        f32 left;
+        f32 top;
+        f32 right;
+        f32 bottom;
+    };
+
+    /**
+     * The image which is decoded by a worker and waits for the upload
+     */
+    struct DecodedImage
+    {
+        String path;
+        Image image;
+    };
+
+    /**
+     * The region of an image in an atlas page
+     */
+    struct AtlasEntry
+    {
+        u32 page;
+        f32 x;
+        f32 y;
+        f32 width;
+        f32 height;
     };
 
     namespace
     {
         Scope<Store<resource_id_t, TextureInfo>> s_textureStore;
 
-        // List<DrawInfo> s_drawList;
-        // List<DrawInfo> s_priorityDrawList;
-
-        // Store all the priorities draw with maximum 256 priorities
-        // The higher priority will be drawn on the top of the lower priority
-        // It should be cleared after each frame
-        Scope<List<DrawInfo>> s_drawLists[MAX_PRIORITIES];
+        // The pages of the atlases and the images (by the path) which are
+        //      packed in them, LoadTexture uses the page instead of loading
+        //      a new texture for these images
+        Dictionary<u32, AtlasPage> s_atlasPages;
+        Dictionary<String, AtlasEntry> s_atlasEntries;
+        u32 s_nextAtlasPage = 0;
+
+        // The images are decoded on the thread pool and uploaded to the GPU
+        //      in GraphicUpdate (the main thread), the mutex guards the queue
+        //      and the number of the decodes which are not finished
+        std::mutex s_decodedMutex;
+        std::condition_variable s_decodesFinished;
+        std::deque<DecodedImage> s_decodedImages;
+        u32 s_pendingDecodes = 0;
+
+        // The commands of the current frame in the submission order, the
+        //      buffer is the frame arena: it's only cleared (not freed) after
+        //      drawing, so the submission does not allocate once the buffer
+        //      has grown to the size of a frame
+        List<DrawCommand> s_drawCommands;
+
+        // The indexes of the commands which are sorted by the priority, the
+        //      higher priority will be drawn on the top of the lower priority,
+        //      the commands of the same priority are sorted by the type and
+        //      the texture, so the sprites with the same texture are batched
+        List<u32> s_drawOrder;
+        List<u32> s_drawRanks; ///< The position of each command in s_drawOrder
+        u32 s_priorityOffsets[MAX_PRIORITIES + 1];
+        i32 s_highestPriority = -1;
+
+        // The texts and the tooltips which are drawn, the index 0 is the
+        //      empty string, the pool is kept between frames (the same texts
+        //      are drawn in every frame) until it's too large
+        List<String> s_strings;
+        std::unordered_map<String, u32> s_stringIndexes;
+
+        // The quads of the current texture batch, flushed when the texture or
+        //      the type of the next command is changed
+        List<TextureQuad> s_batchQuads;
+        resource_id_t s_batchTexture = INVALID_RESOURCE_ID;
+        u32 s_batchKey = INVALID_RESOURCE_ID;
+        u32 s_lastBatchKey = INVALID_RESOURCE_ID;
+
+        // The bounds of the commands of the frame in the world space, each
+        //      camera only draws the commands which are in its view and only
+        //      the commands under the mouse are checked for the hovering
+        SpatialGrid s_spatialGrid;
+        List<u8> s_visibleCommands; ///< TRUE for the commands in the view of the current camera
+        List<u32> s_queriedCommands;
+
+        // The commands whose tooltips are drawn after all commands of the
+        //      camera (the tooltips must not be covered by the next sprites)
+        List<u32> s_tooltipCommands;
+
+        RendererStats s_stats = {};
 
         // Stack of all texture ID which is hovered by the mouse
         // It also be cleared after each frame
@@ -90,6 +227,525 @@ namespace ntt
         Scope<Store<camera_id_t, CameraInfo>> s_cameraStore;
 
         b8 s_test = FALSE;
+
+        u32 InternString(const String &str)
+        {
+            if (str.Length() == 0)
+            {
+                return EMPTY_STRING_INDEX;
+            }
+
+            auto it = s_stringIndexes.find(str);
+
+            if (it != s_stringIndexes.end())
+            {
+                return it->second;
+            }
+
+            u32 index = s_strings.size();
+            s_strings.push_back(str);
+            s_stringIndexes.emplace(str, index);
+            return index;
+        }
+
+        void ResetStringPool()
+        {
+            s_strings.clear();
+            s_stringIndexes.clear();
+            s_strings.push_back("");
+        }
+
+        /**
+         * Append a new command to the frame buffer, nullptr if the priority
+         *      is out of range
+         */
+        DrawCommand *PushDrawCommand(DrawCommandType type, const DrawContext &drawContext)
+        {
+            if (drawContext.priority >= MAX_PRIORITIES)
+            {
+                NTT_ENGINE_WARN("The priority of the drawing is out of range: {}",
+                                static_cast<u32>(drawContext.priority));
+                return nullptr;
+            }
+
+            s_drawCommands.emplace_back();
+
+            auto &command = s_drawCommands.back();
+            command.type = type;
+            command.priority = drawContext.priority;
+            command.entity_id = drawContext.entity_id;
+            command.texture_id = INVALID_RESOURCE_ID;
+            command.textureKey = INVALID_RESOURCE_ID;
+            command.text = EMPTY_STRING_INDEX;
+            command.tooltip = EMPTY_STRING_INDEX;
+
+            if (static_cast<i32>(drawContext.priority) > s_highestPriority)
+            {
+                s_highestPriority = drawContext.priority;
+            }
+
+            return &command;
+        }
+
+        /**
+         * Order the commands by the priority with a counting sort, then the
+         *      textures between two other commands (of the same priority) by
+         *      their texture keys, so they can be drawn in batches. The other
+         *      commands keep their submission order and are never crossed by
+         *      the textures. The order of the overlapping sprites is only
+         *      guaranteed between the priorities or across the other commands.
+         */
+        void SortDrawCommands()
+        {
+            PROFILE_FUNCTION();
+            memset(s_priorityOffsets, 0, sizeof(s_priorityOffsets));
+
+            for (auto &command : s_drawCommands)
+            {
+                s_priorityOffsets[command.priority + 1]++;
+            }
+
+            for (u32 i = 0; i < MAX_PRIORITIES; i++)
+            {
+                s_priorityOffsets[i + 1] += s_priorityOffsets[i];
+            }
+
+            u32 cursors[MAX_PRIORITIES];
+            memcpy(cursors, s_priorityOffsets, sizeof(cursors));
+
+            s_drawOrder.resize(s_drawCommands.size());
+
+            for (u32 i = 0; i < s_drawCommands.size(); i++)
+            {
+                s_drawOrder[cursors[s_drawCommands[i].priority]++] = i;
+            }
+
+            auto compare = [](u32 a, u32 b) -> b8
+            {
+                const auto &first = s_drawCommands[a];
+                const auto &second = s_drawCommands[b];
+
+                if (first.textureKey != second.textureKey)
+                {
+                    return first.textureKey < second.textureKey;
+                }
+
+                return a < b;
+            };
+
+            // the priority ranges are contiguous, so a run of the textures
+            //      also ends at the start of the next priority
+            u32 runStart = 0;
+
+            for (u32 i = 0; i <= s_drawOrder.size(); i++)
+            {
+                if (i < s_drawOrder.size() &&
+                    s_drawCommands[s_drawOrder[i]].type == DRAW_COMMAND_TEXTURE &&
+                    s_drawCommands[s_drawOrder[i]].priority ==
+                        s_drawCommands[s_drawOrder[runStart]].priority)
+                {
+                    continue;
+                }
+
+                if (i - runStart > 1)
+                {
+                    std::sort(s_drawOrder.begin() + runStart,
+                              s_drawOrder.begin() + i,
+                              compare);
+                }
+
+                runStart = i < s_drawOrder.size() &&
+                                   s_drawCommands[s_drawOrder[i]].type == DRAW_COMMAND_TEXTURE
+                               ? i
+                               : i + 1;
+            }
+
+            s_drawRanks.resize(s_drawCommands.size());
+
+            for (u32 i = 0; i < s_drawOrder.size(); i++)
+            {
+                s_drawRanks[s_drawOrder[i]] = i;
+            }
+        }
+
+        /**
+         * The bounds of the sprite (or the rectangle) centered at the position,
+         *      the rotated sprite is bounded by its circumscribed square
+         */
+        ViewRect GetSpriteBounds(f32 x, f32 y, f32 width, f32 height, f32 rotate)
+        {
+            f32 halfWidth = width / 2;
+            f32 halfHeight = height / 2;
+
+            if (rotate != 0.0f)
+            {
+                halfWidth = halfHeight = std::sqrt(width * width + height * height) / 2;
+            }
+
+            return {x - halfWidth, y - halfHeight, x + halfWidth, y + halfHeight};
+        }
+
+        /**
+         * The part of the world which is displayed in the output frame of the camera
+         */
+        ViewRect GetCameraView(const Camera &camera)
+        {
+            return {camera.ReverseTransformX(0),
+                    camera.ReverseTransformY(0),
+                    camera.ReverseTransformX(camera.outputSize.width),
+                    camera.ReverseTransformY(camera.outputSize.height)};
+        }
+
+        /**
+         * Index the bounds of all commands of the frame, the texts are not
+         *      measured, so they are always drawn
+         */
+        void BuildSpatialGrid()
+        {
+            PROFILE_FUNCTION();
+            s_spatialGrid.Clear();
+            s_visibleCommands.resize(s_drawCommands.size());
+
+            for (u32 i = 0; i < s_drawCommands.size(); i++)
+            {
+                const auto &command = s_drawCommands[i];
+
+                if (command.type == DRAW_COMMAND_TEXT)
+                {
+                    s_spatialGrid.InsertUnbounded(i);
+                }
+                else if (command.type == DRAW_COMMAND_LINE)
+                {
+                    s_spatialGrid.Insert(i,
+                                         std::min(command.toX, command.toWidth),
+                                         std::min(command.toY, command.toHeight),
+                                         std::max(command.toX, command.toWidth),
+                                         std::max(command.toY, command.toHeight));
+                }
+                else
+                {
+                    auto bounds = GetSpriteBounds(command.toX,
+                                                  command.toY,
+                                                  command.toWidth,
+                                                  command.toHeight,
+                                                  command.rotate);
+                    s_spatialGrid.Insert(i, bounds.left, bounds.top, bounds.right, bounds.bottom);
+                }
+            }
+        }
+
+        /**
+         * Decode the image on the thread pool, the result is queued for
+         *      UploadDecodedImages
+         */
+        void DecodeImageAsync(const String &path)
+        {
+            {
+                std::lock_guard<std::mutex> lock(s_decodedMutex);
+                s_pendingDecodes++;
+            }
+
+            GraphicAPI *graphicAPI = s_graphicAPI.get();
+
+            ThreadPoolSubmit(
+                [graphicAPI, path]()
+                {
+                    Image image(nullptr, 0, 0);
+
+                    try
+                    {
+                        image = graphicAPI->LoadImage(path);
+                    }
+                    catch (const std::exception &e)
+                    {
+                        NTT_ENGINE_ERROR("Decoding the image {} error: {}", path, e.what());
+                    }
+
+                    std::lock_guard<std::mutex> lock(s_decodedMutex);
+                    s_decodedImages.push_back({path, image});
+                    s_pendingDecodes--;
+                    s_decodesFinished.notify_all();
+                });
+        }
+
+        /**
+         * Wait for the running decodes and drop all the decoded images
+         */
+        void DropDecodedImages()
+        {
+            std::unique_lock<std::mutex> lock(s_decodedMutex);
+            s_decodesFinished.wait(lock, []
+                                   { return s_pendingDecodes == 0; });
+
+            for (auto &decoded : s_decodedImages)
+            {
+                s_graphicAPI->UnloadImage(decoded.image);
+            }
+
+            s_decodedImages.clear();
+        }
+
+        /**
+         * Load the texture synchronously when its decode (or upload) failed,
+         *      if it still cannot be loaded, then it's marked as failed so it
+         *      is neither drawn nor counted as loading anymore
+         */
+        void LoadTextureFallback(Ref<TextureInfo> textureInfo)
+        {
+            auto texture = s_graphicAPI->LoadTexture(textureInfo->path);
+
+            textureInfo->atlasPage = ATLAS_NO_PAGE;
+            textureInfo->x = 0;
+            textureInfo->y = 0;
+
+            if (s_graphicAPI->IsLoadedSuccess(texture) != TRUE)
+            {
+                NTT_ENGINE_WARN("Loading the texture {} error", GetFileName(textureInfo->path, true));
+                textureInfo->failed = TRUE;
+                return;
+            }
+
+            textureInfo->texture = texture;
+            textureInfo->width = static_cast<f32>(texture.width);
+            textureInfo->height = static_cast<f32>(texture.height);
+            textureInfo->frameWith = textureInfo->width / textureInfo->grid.col;
+            textureInfo->frameHeight = textureInfo->height / textureInfo->grid.row;
+            textureInfo->loaded = TRUE;
+        }
+
+        /**
+         * Remove the page and its entries, the images which are still decoding
+         *      for the page are dropped when they are uploaded
+         */
+        void EraseAtlasPage(u32 pageId)
+        {
+            for (auto &atlasImage : s_atlasPages[pageId].images)
+            {
+                s_graphicAPI->UnloadImage(atlasImage.image);
+            }
+
+            s_atlasPages.erase(pageId);
+
+            for (auto it = s_atlasEntries.begin(); it != s_atlasEntries.end();)
+            {
+                if (it->second.page == pageId)
+                {
+                    it = s_atlasEntries.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+        }
+
+        /**
+         * Give up the page which cannot be completed (an image cannot be
+         *      decoded or the page cannot be uploaded), each texture of the
+         *      page is loaded as its own texture
+         */
+        void ReleaseFailedAtlasPage(u32 pageId)
+        {
+            EraseAtlasPage(pageId);
+
+            ForEachFunc<resource_id_t, TextureInfo> func = [&](Ref<TextureInfo> textureInfo, resource_id_t)
+            {
+                if (textureInfo->atlasPage == pageId)
+                {
+                    LoadTextureFallback(textureInfo);
+                }
+            };
+
+            s_textureStore->ForEach(func);
+        }
+
+        /**
+         * Upload the page when all of its images are decoded
+         *
+         * @return The uploaded pixels
+         */
+        u64 UploadAtlasPage(u32 pageId)
+        {
+            auto &page = s_atlasPages[pageId];
+            auto texture = s_graphicAPI->LoadAtlasTexture(page.width, page.height, page.images);
+
+            for (auto &atlasImage : page.images)
+            {
+                s_graphicAPI->UnloadImage(atlasImage.image);
+            }
+
+            page.images.clear();
+
+            if (s_graphicAPI->IsLoadedSuccess(texture) != TRUE)
+            {
+                NTT_ENGINE_WARN("Loading the atlas page with {} images error", page.imagesCount);
+                ReleaseFailedAtlasPage(pageId);
+                return 0;
+            }
+
+            page.texture = texture;
+            page.loaded = TRUE;
+
+            ForEachFunc<resource_id_t, TextureInfo> func = [&](Ref<TextureInfo> textureInfo, resource_id_t)
+            {
+                if (textureInfo->atlasPage == pageId)
+                {
+                    textureInfo->texture = texture;
+                    textureInfo->loaded = TRUE;
+                }
+            };
+
+            s_textureStore->ForEach(func);
+            return static_cast<u64>(page.width) * page.height;
+        }
+
+        /**
+         * Upload the decoded image into its texture (or its atlas page), the
+         *      images of the unloaded textures are dropped
+         *
+         * @return The uploaded pixels
+         */
+        u64 UploadDecodedImage(const DecodedImage &decoded)
+        {
+            if (s_atlasEntries.Contains(decoded.path))
+            {
+                const auto &entry = s_atlasEntries[decoded.path];
+                auto &page = s_atlasPages[entry.page];
+
+                if (page.loaded)
+                {
+                    s_graphicAPI->UnloadImage(decoded.image);
+                    return 0;
+                }
+
+                // the page is not uploaded with a hole, its images are loaded
+                //      separately instead
+                if (decoded.image.width == 0 || decoded.image.height == 0)
+                {
+                    NTT_ENGINE_WARN("Decoding the texture {} error", GetFileName(decoded.path, true));
+                    ReleaseFailedAtlasPage(entry.page);
+                    return 0;
+                }
+
+                page.images.push_back({decoded.image,
+                                       static_cast<u32>(entry.x),
+                                       static_cast<u32>(entry.y)});
+
+                if (page.images.size() < page.imagesCount)
+                {
+                    return 0;
+                }
+
+                return UploadAtlasPage(entry.page);
+            }
+
+            const auto &ids = s_textureStore->GetIdsByKey(decoded.path);
+            Ref<TextureInfo> textureInfo = ids.empty() ? nullptr : s_textureStore->Get(ids[0]);
+
+            if (textureInfo == nullptr || textureInfo->loaded)
+            {
+                s_graphicAPI->UnloadImage(decoded.image);
+                return 0;
+            }
+
+            if (decoded.image.width == 0 || decoded.image.height == 0)
+            {
+                NTT_ENGINE_WARN("Decoding the texture {} error", GetFileName(decoded.path, true));
+                LoadTextureFallback(textureInfo);
+                return 0;
+            }
+
+            auto texture = s_graphicAPI->LoadTextureFromImage(decoded.image);
+            s_graphicAPI->UnloadImage(decoded.image);
+
+            if (s_graphicAPI->IsLoadedSuccess(texture) != TRUE)
+            {
+                NTT_ENGINE_WARN("Uploading the texture {} error", GetFileName(decoded.path, true));
+                LoadTextureFallback(textureInfo);
+                return 0;
+            }
+
+            textureInfo->texture = texture;
+            textureInfo->loaded = TRUE;
+            return static_cast<u64>(textureInfo->width) * textureInfo->height;
+        }
+
+        /**
+         * Upload the decoded images until the budget of the frame is used, so
+         *      a scene with many textures is uploaded over multiple frames
+         */
+        void UploadDecodedImages()
+        {
+            PROFILE_FUNCTION();
+            u64 uploadedPixels = 0;
+
+            while (uploadedPixels < TEXTURE_UPLOAD_BUDGET)
+            {
+                DecodedImage decoded;
+
+                {
+                    std::lock_guard<std::mutex> lock(s_decodedMutex);
+
+                    if (s_decodedImages.empty())
+                    {
+                        return;
+                    }
+
+                    decoded = s_decodedImages.front();
+                    s_decodedImages.pop_front();
+                }
+
+                uploadedPixels += UploadDecodedImage(decoded);
+            }
+        }
+
+        /**
+         * Unload the atlas page when its last texture is unloaded, the images
+         *      of the page are loaded separately after that
+         */
+        void ReleaseAtlasPage(u32 pageId)
+        {
+            auto &page = s_atlasPages[pageId];
+
+            if (page.texturesCount > 1)
+            {
+                page.texturesCount--;
+                return;
+            }
+
+            if (page.loaded)
+            {
+                s_graphicAPI->UnloadTexture(page.texture);
+            }
+
+            EraseAtlasPage(pageId);
+        }
+
+        /**
+         * Draw all the quads of the current batch with a single call
+         */
+        void FlushTextureBatch()
+        {
+            if (s_batchQuads.empty())
+            {
+                return;
+            }
+
+            if (s_batchKey != s_lastBatchKey)
+            {
+                s_stats.textureSwitches++;
+                s_lastBatchKey = s_batchKey;
+            }
+
+            s_graphicAPI->DrawTextureBatch(
+                s_textureStore->Get(s_batchTexture)->texture,
+                s_batchQuads.data(),
+                s_batchQuads.size());
+
+            s_stats.drawCalls++;
+            s_stats.textureBatches++;
+            s_batchQuads.clear();
+        }
     } // namespace
 
     void RendererInit(b8 test)
@@ -100,13 +756,14 @@ namespace ntt
             RESOURCE_ID_DEFAULT,
             TEXTURE_MAX,
             [](Ref<TextureInfo> texture, Ref<TextureInfo> other) -> b8
-            { return texture->path == other->path; });
+            { return texture->path == other->path; },
+            [](Ref<TextureInfo> texture) -> String
+            { return texture->path; });
 
         s_cameraStore = CreateScope<Store<camera_id_t, CameraInfo>>(
             0,
             10,
-            [](Ref<CameraInfo> camera, Ref<CameraInfo> other) -> b8
-            { return FALSE; });
+            nullptr);
 
         if (test)
         {
@@ -118,21 +775,147 @@ namespace ntt
         }
         s_test = test;
 
-        memset(s_drawLists, 0, sizeof(s_drawLists));
+        s_drawCommands.clear();
+        s_drawOrder.clear();
+        s_highestPriority = -1;
+        s_batchQuads.clear();
+        s_tooltipCommands.clear();
+        s_stats = {};
+        ResetStringPool();
+
+        s_atlasPages.clear();
+        s_atlasEntries.clear();
+        s_nextAtlasPage = 0;
     }
 
-    resource_id_t LoadTexture(const String &path, const Grid &grid)
+    void LoadTextureAtlas(const List<String> &paths, b8 async)
     {
         PROFILE_FUNCTION();
 
-        if (!s_test)
+        List<String> imagePaths;
+        List<Image> images;
+        List<Size> sizes;
+
+        for (const auto &path : paths)
+        {
+            if (s_atlasEntries.Contains(path) || s_textureStore->GetIdsByKey(path).size() > 0)
+            {
+                continue;
+            }
+
+            if (!s_test && IsExist(path) == FALSE)
+            {
+                continue;
+            }
+
+            // the asynchronous pages only need the sizes for the packing,
+            //      the images are decoded later
+            Size size(0, 0);
+            Image image(nullptr, 0, 0);
+
+            if (async)
+            {
+                size = s_graphicAPI->LoadImageSize(path);
+            }
+            else
+            {
+                image = s_graphicAPI->LoadImage(path);
+                size = Size(image.width, image.height);
+            }
+
+            if (size.width == 0 || size.height == 0)
+            {
+                s_graphicAPI->UnloadImage(image);
+                continue;
+            }
+
+            imagePaths.push_back(path);
+            images.push_back(image);
+            sizes.push_back(size);
+        }
+
+        auto layout = PackAtlas(sizes, ATLAS_PAGE_SIZE, ATLAS_PADDING);
+
+        for (u32 page = 0; page < layout.pages.size(); page++)
+        {
+            List<AtlasImage> pageImages;
+            List<u32> indexes;
+
+            for (u32 i = 0; i < images.size(); i++)
+            {
+                if (layout.placements[i].page == page)
+                {
+                    pageImages.push_back({images[i], layout.placements[i].x, layout.placements[i].y});
+                    indexes.push_back(i);
+                }
+            }
+
+            // a single image is loaded as its own texture, the page does not
+            //      save any texture switch
+            if (pageImages.size() < 2)
+            {
+                continue;
+            }
+
+            AtlasPage atlasPage;
+            atlasPage.texturesCount = 0;
+            atlasPage.width = static_cast<u32>(layout.pages[page].width);
+            atlasPage.height = static_cast<u32>(layout.pages[page].height);
+            atlasPage.loaded = !async;
+            atlasPage.imagesCount = pageImages.size();
+
+            if (!async)
+            {
+                atlasPage.texture = s_graphicAPI->LoadAtlasTexture(
+                    atlasPage.width,
+                    atlasPage.height,
+                    pageImages);
+
+                if (s_graphicAPI->IsLoadedSuccess(atlasPage.texture) != TRUE)
+                {
+                    NTT_ENGINE_WARN("Loading the atlas page with {} images error", pageImages.size());
+                    continue;
+                }
+            }
+
+            u32 pageId = s_nextAtlasPage++;
+            s_atlasPages[pageId] = atlasPage;
+
+            for (auto index : indexes)
+            {
+                s_atlasEntries[imagePaths[index]] = {pageId,
+                                                     static_cast<f32>(layout.placements[index].x),
+                                                     static_cast<f32>(layout.placements[index].y),
+                                                     static_cast<f32>(sizes[index].width),
+                                                     static_cast<f32>(sizes[index].height)};
+            }
+
+            NTT_ENGINE_DEBUG("Packed {} images into the atlas page {} ({}x{})",
+                             pageImages.size(), pageId,
+                             atlasPage.width, atlasPage.height);
+
+            if (async)
+            {
+                for (auto index : indexes)
+                {
+                    DecodeImageAsync(imagePaths[index]);
+                }
+            }
+        }
+
+        for (auto &image : images)
         {
-            auto existedTexturePaths = s_textureStore->GetByField<String>(
-                path,
-                [](Ref<TextureInfo> texture) -> String
-                { return texture->path; });
+            s_graphicAPI->UnloadImage(image);
+        }
+    }
 
-            if (existedTexturePaths.size() > 0)
+    resource_id_t LoadTexture(const String &path, const Grid &grid, b8 async)
+    {
+        PROFILE_FUNCTION();
+
+        if (!s_test)
+        {
+            if (s_textureStore->GetIdsByKey(path).size() > 0)
             {
                 NTT_ENGINE_WARN("The texture is already loaded",
                                 GetFileName(path, true));
@@ -146,6 +929,44 @@ namespace ntt
             }
         }
 
+        if (s_atlasEntries.Contains(path))
+        {
+            auto &entry = s_atlasEntries[path];
+            auto &page = s_atlasPages[entry.page];
+            auto textureInfo = CreateRef<TextureInfo>(page.texture, grid, path);
+
+            textureInfo->atlasPage = entry.page;
+            textureInfo->x = entry.x;
+            textureInfo->y = entry.y;
+            textureInfo->width = entry.width;
+            textureInfo->height = entry.height;
+            textureInfo->frameWith = entry.width / grid.col;
+            textureInfo->frameHeight = entry.height / grid.row;
+            textureInfo->loaded = page.loaded;
+
+            page.texturesCount++;
+            return s_textureStore->Add(textureInfo);
+        }
+
+        // the size is read from the header, so the texture can be used (and
+        //      sized) right away, the other formats are loaded synchronously
+        Size size = async ? s_graphicAPI->LoadImageSize(path) : Size(0, 0);
+
+        if (size.width != 0 && size.height != 0)
+        {
+            auto textureInfo = CreateRef<TextureInfo>(Texture2D(nullptr, 0, 0), grid, path);
+
+            textureInfo->width = size.width;
+            textureInfo->height = size.height;
+            textureInfo->frameWith = size.width / grid.col;
+            textureInfo->frameHeight = size.height / grid.row;
+            textureInfo->loaded = FALSE;
+
+            auto textureId = s_textureStore->Add(textureInfo);
+            DecodeImageAsync(path);
+            return textureId;
+        }
+
         auto texture = s_graphicAPI->LoadTexture(path);
 
         if (s_graphicAPI->IsLoadedSuccess(texture) != TRUE)
@@ -156,8 +977,10 @@ namespace ntt
 
         auto textureInfo = CreateRef<TextureInfo>(texture, grid, path);
 
-        textureInfo->frameWith = static_cast<f32>(texture.width) / grid.col;
-        textureInfo->frameHeight = static_cast<f32>(texture.height) / grid.row;
+        textureInfo->width = static_cast<f32>(texture.width);
+        textureInfo->height = static_cast<f32>(texture.height);
+        textureInfo->frameWith = textureInfo->width / grid.col;
+        textureInfo->frameHeight = textureInfo->height / grid.row;
         return s_textureStore->Add(textureInfo);
     }
 
@@ -172,8 +995,8 @@ namespace ntt
         }
 
         auto texture = textureInfo->texture;
-        f32 textureWidth = static_cast<f32>(textureInfo->texture.width);
-        f32 textureHeight = static_cast<f32>(textureInfo->texture.height);
+        f32 textureWidth = textureInfo->width;
+        f32 textureHeight = textureInfo->height;
         f32 frameWidth = textureInfo->frameWith;
         f32 frameHeight = textureInfo->frameHeight;
         f32 width = 0.0f;
@@ -266,6 +1089,11 @@ namespace ntt
             return;
         }
 
+        if (textureInfo->failed)
+        {
+            return;
+        }
+
         auto grid = textureInfo->grid;
         Grid frame;
         frame.row = static_cast<u8>(cell.row) >= static_cast<u8>(grid.row)
@@ -279,34 +1107,36 @@ namespace ntt
         f32 frameHeight = textureInfo->frameHeight;
         auto actualSize = ValidateSize(texture_id, context);
 
-        if (drawContext.priority >= MAX_PRIORITIES)
+        // the texture which is still loading is drawn as a rectangle
+        auto info = PushDrawCommand(textureInfo->loaded ? DRAW_COMMAND_TEXTURE : DRAW_COMMAND_RECTANGLE,
+                                    drawContext);
+
+        if (info == nullptr)
         {
-            NTT_ENGINE_WARN("The priority of the texture is out of range: {}",
-                            static_cast<u32>(drawContext.priority));
             return;
         }
 
-        if (s_drawLists[drawContext.priority] == nullptr)
+        if (textureInfo->loaded)
         {
-            s_drawLists[drawContext.priority] = CreateScope<List<DrawInfo>>();
+            info->texture_id = texture_id;
+            info->textureKey = textureInfo->atlasPage != ATLAS_NO_PAGE
+                                   ? ATLAS_TEXTURE_KEY(textureInfo->atlasPage)
+                                   : texture_id;
         }
-
-        DrawInfo info;
-        info.entity_id = drawContext.entity_id;
-        info.texture_id = texture_id;
-        info.fromX = frameWidth * frame.col;
-        info.fromY = frameHeight * frame.row;
-        info.fromWidth = frameWidth;
-        info.fromHeight = frameHeight;
-        info.toX = static_cast<f32>(context.position.x);
-        info.toY = static_cast<f32>(context.position.y);
-        info.toWidth = static_cast<f32>(actualSize.first.width);
-        info.toHeight = static_cast<f32>(actualSize.first.height);
-        info.rotate = static_cast<f32>(context.rotate);
-        info.tooltip = drawContext.tooltip;
-        info.drawText = FALSE;
-
-        s_drawLists[drawContext.priority]->push_back(info);
+        else
+        {
+            info->color = PLACEHOLDER_COLOR;
+        }
+        info->fromX = textureInfo->x + frameWidth * frame.col;
+        info->fromY = textureInfo->y + frameHeight * frame.row;
+        info->fromWidth = frameWidth;
+        info->fromHeight = frameHeight;
+        info->toX = static_cast<f32>(context.position.x);
+        info->toY = static_cast<f32>(context.position.y);
+        info->toWidth = static_cast<f32>(actualSize.first.width);
+        info->toHeight = static_cast<f32>(actualSize.first.height);
+        info->rotate = static_cast<f32>(context.rotate);
+        info->tooltip = InternString(drawContext.tooltip);
     }
 
     void DrawText(const String &text,
@@ -315,26 +1145,18 @@ namespace ntt
     {
         PROFILE_FUNCTION();
 
-        if (s_drawLists[drawContext.priority] == nullptr)
-        {
-            s_drawLists[drawContext.priority] = CreateScope<List<DrawInfo>>();
-        }
+        auto info = PushDrawCommand(DRAW_COMMAND_TEXT, drawContext);
 
-        if (s_drawLists[drawContext.priority] == nullptr)
+        if (info == nullptr)
         {
-            s_drawLists[drawContext.priority] = CreateScope<List<DrawInfo>>();
+            return;
         }
 
-        DrawInfo info;
-        info.entity_id = drawContext.entity_id;
-        info.drawText = TRUE;
-        info.text = text;
-        info.toX = static_cast<f32>(position.x);
-        info.toY = static_cast<f32>(position.y);
-        info.fontSize = drawContext.fontSize;
-        info.color = drawContext.color;
-
-        s_drawLists[drawContext.priority]->push_back(info);
+        info->text = InternString(text);
+        info->toX = static_cast<f32>(position.x);
+        info->toY = static_cast<f32>(position.y);
+        info->fontSize = drawContext.fontSize;
+        info->color = drawContext.color;
     }
 
     void DrawLine(const Position &start, const Position &end,
@@ -342,66 +1164,51 @@ namespace ntt
     {
         PROFILE_FUNCTION();
 
-        if (s_drawLists[drawContext.priority] == nullptr)
-        {
-            s_drawLists[drawContext.priority] = CreateScope<List<DrawInfo>>();
-        }
+        auto info = PushDrawCommand(DRAW_COMMAND_LINE, drawContext);
 
-        if (s_drawLists[drawContext.priority] == nullptr)
+        if (info == nullptr)
         {
-            s_drawLists[drawContext.priority] = CreateScope<List<DrawInfo>>();
+            return;
         }
 
-        DrawInfo info;
-        info.drawLine = TRUE;
-        info.entity_id = drawContext.entity_id;
-        info.toX = static_cast<f32>(start.x);
-        info.toY = static_cast<f32>(start.y);
-        info.toXEnd = static_cast<f32>(end.x);
-        info.toYEnd = static_cast<f32>(end.y);
-        info.color = drawContext.color;
-        info.lineType = drawContext.lineType;
-
-        s_drawLists[drawContext.priority]->push_back(info);
+        info->toX = static_cast<f32>(start.x);
+        info->toY = static_cast<f32>(start.y);
+        info->toWidth = static_cast<f32>(end.x);
+        info->toHeight = static_cast<f32>(end.y);
+        info->color = drawContext.color;
+        info->lineType = drawContext.lineType;
     }
 
     void DrawRectangle(const RectContext &rect, const DrawContext &drawContext)
     {
         PROFILE_FUNCTION();
 
-        if (s_drawLists[drawContext.priority] == nullptr)
-        {
-            s_drawLists[drawContext.priority] = CreateScope<List<DrawInfo>>();
-        }
+        auto info = PushDrawCommand(DRAW_COMMAND_RECTANGLE, drawContext);
 
-        if (s_drawLists[drawContext.priority] == nullptr)
+        if (info == nullptr)
         {
-            s_drawLists[drawContext.priority] = CreateScope<List<DrawInfo>>();
+            return;
         }
 
-        DrawInfo info;
-        info.entity_id = drawContext.entity_id;
-        info.drawText = FALSE;
-        info.toX = static_cast<f32>(rect.position.x);
-        info.toY = static_cast<f32>(rect.position.y);
-        info.toWidth = static_cast<f32>(rect.size.width);
-        info.toHeight = static_cast<f32>(rect.size.height);
-        info.rotate = rect.rotate;
-        info.tooltip = drawContext.tooltip;
-        info.texture_id = INVALID_RESOURCE_ID;
-        info.color = drawContext.color;
-
-        s_drawLists[drawContext.priority]->push_back(info);
+        info->toX = static_cast<f32>(rect.position.x);
+        info->toY = static_cast<f32>(rect.position.y);
+        info->toWidth = static_cast<f32>(rect.size.width);
+        info->toHeight = static_cast<f32>(rect.size.height);
+        info->rotate = rect.rotate;
+        info->tooltip = InternString(drawContext.tooltip);
+        info->texture_id = INVALID_RESOURCE_ID;
+        info->color = drawContext.color;
     }
 
     void GraphicUpdate()
     {
         PROFILE_FUNCTION();
+        UploadDecodedImages();
         s_hoveredTextures.clear();
 
         auto mouse = GetMousePosition();
 
-        auto highestPriority = MAX_PRIORITIES - 1;
+        auto highestPriority = s_highestPriority;
         auto hoveredEntityId = INVALID_ENTITY_ID;
         RectContext context;
         context.position.x = 0;
@@ -410,18 +1217,14 @@ namespace ntt
         context.size.height = 0;
         context.rotate = 0;
 
-        // TODO: can be optimzed for drawing by removing the iteration through
-        //     the empty priorities
+        SortDrawCommands();
+        BuildSpatialGrid();
 
-        for (highestPriority; highestPriority >= 0; highestPriority--)
-        {
-            if (s_drawLists[highestPriority] != nullptr)
-            {
-                break;
-            }
-        }
+        s_stats = {};
+        s_stats.drawCommands = s_drawCommands.size();
+        s_lastBatchKey = INVALID_RESOURCE_ID;
 
-        auto s_availableCameras = s_cameraStore->GetAvailableIds();
+        const auto &s_availableCameras = s_cameraStore->GetAvailableIds();
 
         for (auto cameraId : s_availableCameras)
         {
@@ -437,138 +1240,185 @@ namespace ntt
                 camera->ReverseTransformX(mouse.x),
                 camera->ReverseTransformY(mouse.y)};
 
-            for (auto i = 0; i < MAX_PRIORITIES; i++)
+            // only the commands in the view of the camera are drawn
+            std::fill(s_visibleCommands.begin(), s_visibleCommands.end(), FALSE);
+            s_queriedCommands.clear();
+
+            auto view = GetCameraView(*camera);
+            s_spatialGrid.Query(view.left, view.top, view.right, view.bottom, s_queriedCommands);
+
+            for (auto index : s_queriedCommands)
             {
-                if (s_drawLists[i] == nullptr)
-                {
-                    continue;
-                }
+                s_visibleCommands[index] = TRUE;
+            }
+
+            s_stats.culledCommands += s_drawCommands.size() - s_queriedCommands.size();
 
-                for (auto info : *s_drawLists[i])
+            for (i32 i = 0; i <= highestPriority; i++)
+            {
+                for (u32 order = s_priorityOffsets[i]; order < s_priorityOffsets[i + 1]; order++)
                 {
-                    if (info.drawText)
+                    if (!s_visibleCommands[s_drawOrder[order]])
+                    {
+                        continue;
+                    }
+
+                    const auto &info = s_drawCommands[s_drawOrder[order]];
+
+                    if (info.type != DRAW_COMMAND_TEXTURE || info.textureKey != s_batchKey)
+                    {
+                        FlushTextureBatch();
+                        s_batchTexture = info.texture_id;
+                        s_batchKey = info.textureKey;
+                    }
+
+                    if (info.type == DRAW_COMMAND_TEXT)
                     {
                         s_graphicAPI->DrawText(
-                            info.text,
+                            s_strings[info.text],
                             camera->TransformX(info.toX),
                             camera->TransformY(info.toY),
                             camera->TransformWidth(info.fontSize),
                             info.color);
+                        s_stats.drawCalls++;
                     }
-                    else if (info.drawLine)
+                    else if (info.type == DRAW_COMMAND_LINE)
                     {
                         s_graphicAPI->DrawLine(
                             camera->TransformX(info.toX),
                             camera->TransformY(info.toY),
-                            camera->TransformX(info.toXEnd),
-                            camera->TransformY(info.toYEnd),
+                            camera->TransformX(info.toWidth),
+                            camera->TransformY(info.toHeight),
                             info.color,
                             info.lineType);
+                        s_stats.drawCalls++;
+                    }
+                    else if (info.type == DRAW_COMMAND_RECTANGLE)
+                    {
+                        s_graphicAPI->DrawRectanglePro(
+                            camera->TransformX(info.toX),
+                            camera->TransformY(info.toY),
+                            camera->TransformWidth(info.toWidth),
+                            camera->TransformHeight(info.toHeight),
+                            info.rotate,
+                            info.color);
+                        s_stats.drawCalls++;
                     }
                     else
                     {
-                        if (info.texture_id == INVALID_RESOURCE_ID)
+                        s_batchQuads.push_back({info.fromX,
+                                                info.fromY,
+                                                info.fromWidth,
+                                                info.fromHeight,
+                                                camera->TransformX(info.toX),
+                                                camera->TransformY(info.toY),
+                                                camera->TransformWidth(info.toWidth),
+                                                camera->TransformHeight(info.toHeight),
+                                                info.rotate});
+                    }
+                }
+
+                FlushTextureBatch();
+                s_batchTexture = INVALID_RESOURCE_ID;
+                s_batchKey = INVALID_RESOURCE_ID;
+            }
+
+            s_tooltipCommands.clear();
+
+            if (cameraInfo->hoverChecking)
+            {
+                // only the commands in the cell under the mouse are checked,
+                //      in the drawing order (the top most is the last one)
+                s_queriedCommands.clear();
+                s_spatialGrid.QueryPoint(transformedMouse.x, transformedMouse.y, s_queriedCommands);
+
+                std::sort(s_queriedCommands.begin(), s_queriedCommands.end(),
+                          [](u32 a, u32 b)
+                          { return s_drawRanks[a] < s_drawRanks[b]; });
+
+                for (auto index : s_queriedCommands)
+                {
+                    const auto &info = s_drawCommands[index];
+
+                    if (info.type != DRAW_COMMAND_TEXTURE && info.type != DRAW_COMMAND_RECTANGLE)
+                    {
+                        continue;
+                    }
+
+                    if (info.entity_id == INVALID_ENTITY_ID)
+                    {
+                        continue;
+                    }
+
+                    if (info.toX - info.toWidth / 2 <= transformedMouse.x &&
+                        transformedMouse.x <= info.toX + info.toWidth / 2 &&
+                        info.toY - info.toHeight / 2 <= transformedMouse.y &&
+                        transformedMouse.y <= info.toY + info.toHeight / 2)
+                    {
+                        s_hoveredTextures.push_back(info.entity_id);
+
+                        if (info.priority < MAX_PRIORITIES - LAYER_PRIORITY_RANGE)
                         {
-                            s_graphicAPI->DrawRectanglePro(
-                                camera->TransformX(info.toX),
-                                camera->TransformY(info.toY),
-                                camera->TransformWidth(info.toWidth),
-                                camera->TransformHeight(info.toHeight),
-                                info.rotate,
-                                info.color);
+                            // store the highest priority hovered texture
+                            hoveredEntityId = info.entity_id;
+                            context.position.x = info.toX;
+                            context.position.y = info.toY;
+                            context.size.width = static_cast<ntt_size_t>(info.toWidth);
+                            context.size.height = static_cast<ntt_size_t>(info.toHeight);
+                            context.rotate = info.rotate;
                         }
                         else
                         {
-                            s_graphicAPI->DrawTexture(
-                                s_textureStore->Get(info.texture_id)->texture,
-                                info.fromX,
-                                info.fromY,
-                                info.fromWidth,
-                                info.fromHeight,
-                                camera->TransformX(info.toX),
-                                camera->TransformY(info.toY),
-                                camera->TransformWidth(info.toWidth),
-                                camera->TransformHeight(info.toHeight),
-                                info.rotate);
+                            hoveredEntityId = INVALID_ENTITY_ID;
                         }
 
-                        if (cameraInfo->hoverChecking == FALSE)
+                        if (info.tooltip != EMPTY_STRING_INDEX &&
+                            info.priority == highestPriority &&
+                            info.priority < MAX_PRIORITIES - LAYER_PRIORITY_RANGE)
                         {
-                            continue;
+                            s_tooltipCommands.push_back(index);
                         }
+                    }
+                }
+            }
 
-                        if (info.entity_id == INVALID_ENTITY_ID)
-                        {
-                            continue;
-                        }
+            for (auto index : s_tooltipCommands)
+            {
+                const auto &info = s_drawCommands[index];
+                const auto &tooltip = s_strings[info.tooltip];
+                auto windowSize = GetWindowSize();
 
-                        if (info.toX - info.toWidth / 2 <= transformedMouse.x &&
-                            transformedMouse.x <= info.toX + info.toWidth / 2 &&
-                            info.toY - info.toHeight / 2 <= transformedMouse.y &&
-                            transformedMouse.y <= info.toY + info.toHeight / 2)
-                        {
-                            s_hoveredTextures.push_back(info.entity_id);
-
-                            if (i < MAX_PRIORITIES - LAYER_PRIORITY_RANGE)
-                            {
-                                // store the highest priority hovered texture
-                                hoveredEntityId = info.entity_id;
-                                context.position.x = info.toX;
-                                context.position.y = info.toY;
-                                context.size.width = static_cast<ntt_size_t>(info.toWidth);
-                                context.size.height = static_cast<ntt_size_t>(info.toHeight);
-                                context.rotate = info.rotate;
-                            }
-                            else
-                            {
-                                hoveredEntityId = INVALID_ENTITY_ID;
-                            }
-
-                            if (info.tooltip != "" &&
-                                i == highestPriority &&
-                                i < MAX_PRIORITIES - LAYER_PRIORITY_RANGE)
-                            {
-                                auto windowSize = GetWindowSize();
-
-                                auto textWidth = s_graphicAPI->GetTextWidth(
-                                    info.tooltip,
-                                    TOOL_TIP_FONT_SIZE);
-                                auto textHeight = TOOL_TIP_FONT_SIZE;
-
-                                auto toolTipX = transformedMouse.x + TOOL_TOP_OFFSET_X;
-
-                                if (toolTipX + textWidth > windowSize.width)
-                                {
-                                    toolTipX -= (textWidth + TOOL_TIP_PADDING * 2 + TOOL_TOP_OFFSET_X);
-                                }
-
-                                auto toolTipY = transformedMouse.y + TOOL_TOP_OFFSET_Y;
-
-                                if (toolTipY + textHeight > windowSize.height)
-                                {
-                                    toolTipY -= textHeight - TOOL_TIP_PADDING * 2 - TOOL_TOP_OFFSET_Y;
-                                }
-
-                                s_graphicAPI->DrawRectangle(
-                                    toolTipX,
-                                    toolTipY,
-                                    textWidth + TOOL_TIP_PADDING * 2,
-                                    textHeight + TOOL_TIP_PADDING * 2,
-                                    {0, 255, 255, 255});
-
-                                s_graphicAPI->DrawText(info.tooltip,
-                                                       toolTipX + TOOL_TIP_PADDING,
-                                                       toolTipY + TOOL_TIP_PADDING,
-                                                       TOOL_TIP_FONT_SIZE, info.color);
-                            }
-                        }
-                    }
+                auto textWidth = s_graphicAPI->GetTextWidth(
+                    tooltip,
+                    TOOL_TIP_FONT_SIZE);
+                auto textHeight = TOOL_TIP_FONT_SIZE;
+
+                auto toolTipX = transformedMouse.x + TOOL_TOP_OFFSET_X;
+
+                if (toolTipX + textWidth > windowSize.width)
+                {
+                    toolTipX -= (textWidth + TOOL_TIP_PADDING * 2 + TOOL_TOP_OFFSET_X);
                 }
 
-                s_drawLists[i]->clear();
-                s_drawLists[i].reset();
+                auto toolTipY = transformedMouse.y + TOOL_TOP_OFFSET_Y;
 
-                ASSERT(s_drawLists[i] == nullptr);
+                if (toolTipY + textHeight > windowSize.height)
+                {
+                    toolTipY -= textHeight - TOOL_TIP_PADDING * 2 - TOOL_TOP_OFFSET_Y;
+                }
+
+                s_graphicAPI->DrawRectangle(
+                    toolTipX,
+                    toolTipY,
+                    textWidth + TOOL_TIP_PADDING * 2,
+                    textHeight + TOOL_TIP_PADDING * 2,
+                    {0, 255, 255, 255});
+
+                s_graphicAPI->DrawText(tooltip,
+                                       toolTipX + TOOL_TIP_PADDING,
+                                       toolTipY + TOOL_TIP_PADDING,
+                                       TOOL_TIP_FONT_SIZE, info.color);
+                s_stats.drawCalls += 2;
             }
 
             s_graphicAPI->DrawNoFillRectangle(
@@ -577,6 +1427,17 @@ namespace ntt
                 camera->TransformWidth(projectSpaceWidth),
                 camera->TransformHeight(projectSpaceHeight),
                 {255, 255, 255, 255});
+            s_stats.drawCalls++;
+        }
+
+        // all cameras draw the same commands, the buffers keep their memory
+        //      for the next frame
+        s_drawCommands.clear();
+        s_highestPriority = -1;
+
+        if (s_strings.size() > MAX_INTERNED_STRINGS)
+        {
+            ResetStringPool();
         }
     }
 
@@ -617,6 +1478,44 @@ namespace ntt
         return s_hoveredTextures;
     }
 
+    RendererStats GetRendererStats()
+    {
+        return s_stats;
+    }
+
+    b8 IsInCameraView(const Position &position, const Size &size, f32 rotate)
+    {
+        PROFILE_FUNCTION();
+        auto bounds = GetSpriteBounds(position.x, position.y, size.width, size.height, rotate);
+
+        for (auto cameraId : s_cameraStore->GetAvailableIds())
+        {
+            auto view = GetCameraView(*s_cameraStore->Get(cameraId)->camera);
+
+            if (bounds.left <= view.right && view.left <= bounds.right &&
+                bounds.top <= view.bottom && view.top <= bounds.bottom)
+            {
+                return TRUE;
+            }
+        }
+
+        return FALSE;
+    }
+
+    u32 GetLoadingTexturesCount()
+    {
+        PROFILE_FUNCTION();
+        u32 count = 0;
+
+        ForEachFunc<resource_id_t, TextureInfo> func = [&](Ref<TextureInfo> textureInfo, resource_id_t)
+        {
+            count += textureInfo->loaded || textureInfo->failed ? 0 : 1;
+        };
+
+        s_textureStore->ForEach(func);
+        return count;
+    }
+
     void UnloadTexture(resource_id_t texture_id)
     {
         PROFILE_FUNCTION();
@@ -627,9 +1526,25 @@ namespace ntt
             return;
         }
 
+        auto textureInfo = s_textureStore->Get(texture_id);
+
+        if (textureInfo->atlasPage != ATLAS_NO_PAGE)
+        {
+            ReleaseAtlasPage(textureInfo->atlasPage);
+            s_textureStore->Release(texture_id);
+            return;
+        }
+
+        // the image which is still decoding is dropped when it's uploaded
+        if (!textureInfo->loaded)
+        {
+            s_textureStore->Release(texture_id);
+            return;
+        }
+
         try
         {
-            s_graphicAPI->UnloadTexture(s_textureStore->Get(texture_id)->texture);
+            s_graphicAPI->UnloadTexture(textureInfo->texture);
         }
         catch (const std::exception &e)
         {
@@ -650,10 +1565,39 @@ namespace ntt
 
         s_textureStore->ForEach(func);
 
-        ASSERT_M(s_textureStore->GetAvailableIds().size() == 0,
+        ASSERT_M(s_textureStore->Count() == 0,
                  "The texture store is not empty");
 
+        DropDecodedImages();
+
+        // the pages whose images are never loaded
+        for (auto &page : s_atlasPages)
+        {
+            if (page.second.loaded)
+            {
+                s_graphicAPI->UnloadTexture(page.second.texture);
+            }
+
+            for (auto &atlasImage : page.second.images)
+            {
+                s_graphicAPI->UnloadImage(atlasImage.image);
+            }
+        }
+
+        s_atlasPages.clear();
+        s_atlasEntries.clear();
+
         s_textureStore.reset();
         s_cameraStore.reset();
+
+        s_drawCommands = {};
+        s_drawOrder = {};
+        s_drawRanks = {};
+        s_spatialGrid = SpatialGrid();
+        s_visibleCommands = {};
+        s_queriedCommands = {};
+        s_batchQuads = {};
+        s_tooltipCommands = {};
+        ResetStringPool();
     }
 } // namespace ntt
\ No newline at end of file
@@ -3,6 +3,11 @@
 
 namespace ntt
 {
+    Ref<ComponentBase> Hovering::Clone() const
+    {
+        return CreatePooledRef<Hovering>(*this);
+    }
+
     String Hovering::GetName() const
     {
         return "Hovering";
@@ -35,7 +35,11 @@ namespace ntt
         grid.row = gridInfo.Get("row", grid.row);
         grid.col = gridInfo.Get("col", grid.col);
 
-        m_Impl->textureId = LoadTexture(m_Impl->path, grid);
+        // the images are decoded in the background by default, so loading
+        //      a scene does not block the frames
+        m_Impl->textureId = LoadTexture(m_Impl->path,
+                                        grid,
+                                        m_Impl->additionalInfo.Get<b8>("async", TRUE));
 
         NTT_ENGINE_DEBUG("Loaded image resource: {}", GetInfo()->name);
         return m_Impl->textureId;
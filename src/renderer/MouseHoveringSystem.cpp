@@ -47,9 +47,8 @@ namespace ntt
     void MouseHoveringSystem::Update(f32 delta, entity_id_t id)
     {
         PROFILE_FUNCTION();
-        auto hovering = ECS_GET_COMPONENT(id, Hovering);
-        auto geo = ECS_GET_COMPONENT(id, Geometry);
-        auto texture = ECS_GET_COMPONENT(id, TextureComponent);
+        auto hovering = ECS_READ_COMPONENT(id, Hovering);
+        auto texture = ECS_READ_COMPONENT(id, TextureComponent);
 
         auto callback = hovering->callback;
         auto onEnterCallback = hovering->onEnterCallback;
@@ -89,8 +88,11 @@ namespace ntt
             hovering->hoveredCell.row != 255 &&
             texture != nullptr)
         {
-            hovering->prevHoveredCell = texture->currentCell;
-            texture->currentCell = hovering->hoveredCell;
+            auto changedHovering = ECS_GET_COMPONENT(id, Hovering);
+            auto changedTexture = ECS_GET_COMPONENT(id, TextureComponent);
+
+            changedHovering->prevHoveredCell = changedTexture->currentCell;
+            changedTexture->currentCell = changedHovering->hoveredCell;
         }
     }
 
@@ -1,13 +1,316 @@
 #include <NTTEngine/renderer/ParentSystem.hpp>
 #include <NTTEngine/renderer/Geometry.hpp>
 #include <NTTEngine/renderer/Parent.hpp>
+#include <NTTEngine/core/logging/logging.hpp>
+#include <NTTEngine/core/profiling.hpp>
 #include <cmath>
 
 namespace ntt
 {
+#define ROOT_NODE 0xFFFFFFFF
+#define DEGREE_TO_RADIAN (3.14159265f / 180.0f)
+
+    /**
+     * The hierarchy of all entities which have the Parent component, the
+     *      nodes are stored in the depth-first order (each parent is placed
+     *      before its children, and each subtree is contiguous), so the world
+     *      transforms are resolved in a single pass without depending on the
+     *      order of the entities in the ECS.
+     *
+     * The node data is kept in separated arrays (structure of arrays), the
+     *      world transform of each node is cached so a child only reads the
+     *      cached values of its parent, and only the dirty nodes (moved
+     *      themselves or having a moved ancestor) are recomputed.
+     */
     class ParentSystem::Impl
     {
     public:
+        List<entity_id_t> children;    ///< All entities which are handled by the system
+        b8 structureChanged = TRUE;    ///< The nodes must be rebuilt before the next update
+        Dictionary<entity_id_t, u32> nodeIndex;
+
+        // the nodes in the depth-first order
+        List<entity_id_t> ids;
+        List<entity_id_t> parentIds;
+        List<u32> parents; ///< The index of the parent node, ROOT_NODE if the parent is not a node
+        List<entity_id_t> rootIds; ///< The top entity of the hierarchy (not a node)
+        List<b8> dirty;
+        List<u32> updatedFrame; ///< The entity is in the batch of the given frame
+
+        // the local transforms (copied from the Parent components)
+        List<f32> localX;
+        List<f32> localY;
+        List<f32> localAngle;
+
+        // the cached world transforms
+        List<f32> worldX;
+        List<f32> worldY;
+        List<f32> worldRotation;
+        List<f32> worldCos;
+        List<f32> worldSin;
+
+        u32 frame = 0;
+
+        void Rebuild()
+        {
+            PROFILE_FUNCTION();
+
+            Dictionary<entity_id_t, List<entity_id_t>> childrenOf;
+            Dictionary<entity_id_t, b8> isChild;
+
+            for (auto id : children)
+            {
+                auto parent = ECS_READ_COMPONENT(id, Parent);
+
+                if (parent == nullptr)
+                {
+                    continue;
+                }
+
+                childrenOf[parent->parentId].push_back(id);
+                isChild[id] = TRUE;
+            }
+
+            ids.clear();
+            parentIds.clear();
+            parents.clear();
+            rootIds.clear();
+            nodeIndex.clear();
+
+            // the roots are the parents which are not the children themselves
+            for (auto &pair : childrenOf)
+            {
+                if (isChild.Contains(pair.first))
+                {
+                    continue;
+                }
+
+                for (auto child : pair.second)
+                {
+                    AddSubtree(child, pair.first, ROOT_NODE, childrenOf);
+                }
+            }
+
+            if (ids.size() < isChild.size())
+            {
+                NTT_ENGINE_WARN("The parent hierarchy contains a cycle, {} entities are skipped",
+                                isChild.size() - ids.size());
+            }
+
+            u32 count = ids.size();
+            dirty.resize(count);
+            updatedFrame.assign(count, 0);
+            localX.resize(count);
+            localY.resize(count);
+            localAngle.resize(count);
+            worldX.resize(count);
+            worldY.resize(count);
+            worldRotation.resize(count);
+            worldCos.resize(count);
+            worldSin.resize(count);
+
+            structureChanged = FALSE;
+        }
+
+        void AddSubtree(entity_id_t id,
+                        entity_id_t parentId,
+                        u32 parentNode,
+                        Dictionary<entity_id_t, List<entity_id_t>> &childrenOf)
+        {
+            u32 index = ids.size();
+
+            nodeIndex[id] = index;
+            ids.push_back(id);
+            parentIds.push_back(parentId);
+            parents.push_back(parentNode);
+            rootIds.push_back(parentNode == ROOT_NODE ? parentId : rootIds[parentNode]);
+
+            if (!childrenOf.Contains(id))
+            {
+                return;
+            }
+
+            for (auto child : childrenOf[id])
+            {
+                AddSubtree(child, id, index, childrenOf);
+            }
+        }
+
+        /**
+         * Check which nodes must be recomputed and copy their local transforms,
+         *      the nodes outside the current batch (in the layers which are
+         *      not updated) keep their cached transforms.
+         *
+         * @param forceAll All nodes are dirty (after rebuilding)
+         */
+        void CollectDirtyNodes(b8 forceAll)
+        {
+            entity_id_t cachedRootId = INVALID_ENTITY_ID;
+            b8 cachedRootChanged = FALSE;
+
+            for (u32 i = 0; i < ids.size(); i++)
+            {
+                dirty[i] = FALSE;
+
+                // the nodes outside the batch are only resolved once after
+                //      rebuilding, so their children have valid parents
+                if (!forceAll && updatedFrame[i] != frame)
+                {
+                    continue;
+                }
+
+                b8 parentDirty = FALSE;
+
+                if (parents[i] == ROOT_NODE)
+                {
+                    // the siblings are placed together, so the root is
+                    //      only checked once for all of its children
+                    if (parentIds[i] != cachedRootId)
+                    {
+                        cachedRootId = parentIds[i];
+                        cachedRootChanged = ECS_IS_CHANGED(cachedRootId, Geometry);
+                    }
+
+                    parentDirty = cachedRootChanged;
+                }
+                else
+                {
+                    parentDirty = dirty[parents[i]];
+                }
+
+                // the geometry of the child is also reset when it's changed
+                //      by the others
+                if (!forceAll &&
+                    !parentDirty &&
+                    !ECS_IS_CHANGED(ids[i], Parent) &&
+                    !ECS_IS_CHANGED(ids[i], Geometry))
+                {
+                    continue;
+                }
+
+                auto parent = ECS_READ_COMPONENT(ids[i], Parent);
+
+                if (parent == nullptr)
+                {
+                    continue;
+                }
+
+                if (parents[i] == ROOT_NODE)
+                {
+                    auto rootGeo = ECS_READ_COMPONENT(parentIds[i], Geometry);
+
+                    if (rootGeo == nullptr)
+                    {
+                        continue;
+                    }
+
+                    // the root transform is placed in the slot of the child
+                    //      itself and replaced by ComputeWorldTransforms
+                    worldX[i] = rootGeo->pos.x;
+                    worldY[i] = rootGeo->pos.y;
+                    worldRotation[i] = rootGeo->rotation;
+                }
+
+                localX[i] = parent->relPos.x;
+                localY[i] = parent->relPos.y;
+                localAngle[i] = parent->angle;
+                dirty[i] = TRUE;
+            }
+        }
+
+        /**
+         * Compose the world transforms of the dirty nodes, the loop only
+         *      touches the node arrays (the parents are always resolved
+         *      before their children).
+         */
+        void ComputeWorldTransforms()
+        {
+            PROFILE_FUNCTION();
+
+            for (u32 i = 0; i < ids.size(); i++)
+            {
+                if (!dirty[i])
+                {
+                    continue;
+                }
+
+                f32 parentX, parentY, parentRotation, parentCos, parentSin;
+                u32 parentNode = parents[i];
+
+                if (parentNode == ROOT_NODE)
+                {
+                    parentX = worldX[i];
+                    parentY = worldY[i];
+                    parentRotation = worldRotation[i];
+                    parentCos = std::cos(parentRotation * DEGREE_TO_RADIAN);
+                    parentSin = std::sin(parentRotation * DEGREE_TO_RADIAN);
+                }
+                else
+                {
+                    parentX = worldX[parentNode];
+                    parentY = worldY[parentNode];
+                    parentRotation = worldRotation[parentNode];
+                    parentCos = worldCos[parentNode];
+                    parentSin = worldSin[parentNode];
+                }
+
+                worldX[i] = parentX + localX[i] * parentCos - localY[i] * parentSin;
+                worldY[i] = parentY + localX[i] * parentSin + localY[i] * parentCos;
+                worldRotation[i] = parentRotation + localAngle[i];
+
+                if (localAngle[i] == 0)
+                {
+                    worldCos[i] = parentCos;
+                    worldSin[i] = parentSin;
+                }
+                else
+                {
+                    worldCos[i] = std::cos(worldRotation[i] * DEGREE_TO_RADIAN);
+                    worldSin[i] = std::sin(worldRotation[i] * DEGREE_TO_RADIAN);
+                }
+            }
+        }
+
+        void WriteGeometries()
+        {
+            entity_id_t cachedRootId = INVALID_ENTITY_ID;
+            Ref<const Geometry> rootGeo;
+
+            for (u32 i = 0; i < ids.size(); i++)
+            {
+                if (!dirty[i])
+                {
+                    continue;
+                }
+
+                auto geo = ECS_GET_COMPONENT(ids[i], Geometry);
+
+                if (geo == nullptr)
+                {
+                    continue;
+                }
+
+                geo->pos.x = worldX[i];
+                geo->pos.y = worldY[i];
+                geo->rotation = worldRotation[i];
+
+                if (rootIds[i] != cachedRootId)
+                {
+                    cachedRootId = rootIds[i];
+                    rootGeo = ECS_READ_COMPONENT(cachedRootId, Geometry);
+                }
+
+                // the root is moved by the fixed steps, the children follow its
+                //      interpolation so they are not drawn ahead of it
+                if (rootGeo != nullptr && rootGeo->lastStep != 0)
+                {
+                    geo->lastPos.x = geo->pos.x - (rootGeo->pos.x - rootGeo->lastPos.x);
+                    geo->lastPos.y = geo->pos.y - (rootGeo->pos.y - rootGeo->lastPos.y);
+                    geo->lastRotation = geo->rotation - (rootGeo->rotation - rootGeo->lastRotation);
+                    geo->lastStep = rootGeo->lastStep;
+                }
+            }
+        }
     };
 
     ParentSystem::ParentSystem()
@@ -21,55 +324,76 @@ namespace ntt
 
     void ParentSystem::InitSystem()
     {
+        m_impl->children.clear();
+        m_impl->structureChanged = TRUE;
     }
 
     void ParentSystem::InitEntity(entity_id_t id)
     {
-        auto geo = ECS_GET_COMPONENT(id, Geometry);
-        auto parent = ECS_GET_COMPONENT(id, Parent);
-
-        if (geo == nullptr || parent == nullptr)
-        {
-            return;
-        }
-
-        auto parentGeo = ECS_GET_COMPONENT(parent->parentId, Geometry);
-
-        if (parentGeo == nullptr)
-        {
-            return;
-        }
+        m_impl->children.push_back(id);
+        m_impl->structureChanged = TRUE;
     }
 
     void ParentSystem::Update(f32 delta, entity_id_t id)
     {
-        auto geo = ECS_GET_COMPONENT(id, Geometry);
-        auto parent = ECS_GET_COMPONENT(id, Parent);
+        UpdateBatch(delta, Span<const entity_id_t>(&id, 1));
+    }
+
+    void ParentSystem::UpdateBatch(f32 delta, Span<const entity_id_t> ids)
+    {
+        PROFILE_FUNCTION();
+
+        m_impl->frame++;
 
-        if (geo == nullptr || parent == nullptr)
+        for (auto id : ids)
         {
-            return;
+            if (m_impl->structureChanged)
+            {
+                break;
+            }
+
+            // the parent of the entity is replaced
+            if (ECS_IS_CHANGED(id, Parent) && m_impl->nodeIndex.Contains(id))
+            {
+                auto parent = ECS_READ_COMPONENT(id, Parent);
+
+                if (parent != nullptr &&
+                    parent->parentId != m_impl->parentIds[m_impl->nodeIndex[id]])
+                {
+                    m_impl->structureChanged = TRUE;
+                }
+            }
         }
 
-        auto parentGeo = ECS_GET_COMPONENT(parent->parentId, Geometry);
+        b8 rebuilt = m_impl->structureChanged;
 
-        if (parentGeo == nullptr)
+        if (rebuilt)
         {
-            return;
+            m_impl->Rebuild();
         }
 
-        f32 rotation = parentGeo->rotation * 3.14 / 180;
-        geo->pos.x = parentGeo->pos.x + parent->relPos.x * cos(rotation) - parent->relPos.y * sin(rotation);
-        geo->pos.y = parentGeo->pos.y + parent->relPos.x * sin(rotation) + parent->relPos.y * cos(rotation);
+        for (auto id : ids)
+        {
+            if (m_impl->nodeIndex.Contains(id))
+            {
+                m_impl->updatedFrame[m_impl->nodeIndex[id]] = m_impl->frame;
+            }
+        }
 
-        geo->rotation = parentGeo->rotation;
+        m_impl->CollectDirtyNodes(rebuilt);
+        m_impl->ComputeWorldTransforms();
+        m_impl->WriteGeometries();
     }
 
     void ParentSystem::ShutdownEntity(entity_id_t id)
     {
+        m_impl->children.RemoveItem(id);
+        m_impl->structureChanged = TRUE;
     }
 
     void ParentSystem::ShutdownSystem()
     {
+        m_impl->children.clear();
+        m_impl->nodeIndex.clear();
     }
 } // namespace ntt
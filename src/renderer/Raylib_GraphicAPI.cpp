@@ -1,9 +1,16 @@
 #include "Raylib_GraphicAPI.hpp"
 #include <raylib.h>
 #include <raymath.h>
+#include <rlgl.h>
+#include <cmath>
+#include <cstring>
+#include <fstream>
 
 namespace ntt
 {
+#define BATCH_CHUNK_QUADS 1024 ///< The quads which are pushed between two checks of the rlgl buffer
+#define PNG_HEADER_SIZE 24     ///< The signature and the IHDR chunk until the height
+
     class RaylibGraphicAPI::Impl
     {
     public:
@@ -57,6 +64,103 @@ namespace ntt
         return std::static_pointer_cast<::Texture2D>(texture.texture)->id != 0;
     }
 
+    Image RaylibGraphicAPI::LoadImage(const String &path)
+    {
+        auto image = CreateRef<::Image>(::LoadImage(path.RawString().c_str()));
+
+        if (image->data == nullptr)
+        {
+            return Image(nullptr, 0, 0);
+        }
+
+        return Image(
+            std::static_pointer_cast<void>(image),
+            static_cast<f32>(image->width),
+            static_cast<f32>(image->height));
+    }
+
+    void RaylibGraphicAPI::UnloadImage(Image image)
+    {
+        if (image.image == nullptr)
+        {
+            return;
+        }
+
+        ::UnloadImage(*std::static_pointer_cast<::Image>(image.image));
+    }
+
+    Size RaylibGraphicAPI::LoadImageSize(const String &path)
+    {
+        static const u8 signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+        std::ifstream file(path.RawString(), std::ios::binary);
+        u8 header[PNG_HEADER_SIZE];
+
+        if (!file.read(reinterpret_cast<char *>(header), PNG_HEADER_SIZE) ||
+            std::memcmp(header, signature, sizeof(signature)) != 0 ||
+            std::memcmp(header + 12, "IHDR", 4) != 0)
+        {
+            return Size(0, 0);
+        }
+
+        // the width and the height are big endian
+        auto readU32 = [&](u32 offset) -> u32
+        {
+            return (static_cast<u32>(header[offset]) << 24) |
+                   (static_cast<u32>(header[offset + 1]) << 16) |
+                   (static_cast<u32>(header[offset + 2]) << 8) |
+                   static_cast<u32>(header[offset + 3]);
+        };
+
+        return Size(static_cast<f32>(readU32(16)), static_cast<f32>(readU32(20)));
+    }
+
+    Texture2D RaylibGraphicAPI::LoadTextureFromImage(Image image)
+    {
+        ::Image *image2D = std::static_pointer_cast<::Image>(image.image).get();
+        auto texture = CreateRef<::Texture2D>(::LoadTextureFromImage(*image2D));
+        return Texture2D(
+            std::static_pointer_cast<void>(texture),
+            static_cast<f32>(texture->width),
+            static_cast<f32>(texture->height));
+    }
+
+    Texture2D RaylibGraphicAPI::LoadAtlasTexture(u32 width,
+                                                 u32 height,
+                                                 const List<AtlasImage> &images)
+    {
+        ::Image atlas = ::GenImageColor(width, height, ::BLANK);
+
+        for (const auto &atlasImage : images)
+        {
+            if (atlasImage.image.image == nullptr)
+            {
+                continue;
+            }
+
+            ::Image *image = std::static_pointer_cast<::Image>(atlasImage.image.image).get();
+
+            ::ImageDraw(&atlas,
+                        *image,
+                        ::Rectangle{0, 0,
+                                    static_cast<f32>(image->width),
+                                    static_cast<f32>(image->height)},
+                        ::Rectangle{static_cast<f32>(atlasImage.x),
+                                    static_cast<f32>(atlasImage.y),
+                                    static_cast<f32>(image->width),
+                                    static_cast<f32>(image->height)},
+                        ::WHITE);
+        }
+
+        auto texture = CreateRef<::Texture2D>(::LoadTextureFromImage(atlas));
+        ::UnloadImage(atlas);
+
+        return Texture2D(
+            std::static_pointer_cast<void>(texture),
+            static_cast<f32>(texture->width),
+            static_cast<f32>(texture->height));
+    }
+
     void RaylibGraphicAPI::DrawText(
         const String &text,
         f32 x,
@@ -115,6 +219,73 @@ namespace ntt
                          ::WHITE);
     }
 
+    void RaylibGraphicAPI::DrawTextureBatch(Texture2D texture,
+                                            const TextureQuad *quads,
+                                            u32 count)
+    {
+        ::Texture2D *texture2D = std::static_pointer_cast<::Texture2D>(texture.texture).get();
+        f32 width = static_cast<f32>(texture2D->width);
+        f32 height = static_cast<f32>(texture2D->height);
+
+        // the same vertices as DrawTexturePro (origin at the center of the
+        //      destination), but the texture is only set once, so all the
+        //      quads are merged into one draw call of the rlgl batch
+        for (u32 start = 0; start < count; start += BATCH_CHUNK_QUADS)
+        {
+            u32 end = start + BATCH_CHUNK_QUADS < count ? start + BATCH_CHUNK_QUADS : count;
+
+            rlCheckRenderBatchLimit(static_cast<int>((end - start) * 4));
+            rlSetTexture(texture2D->id);
+            rlBegin(RL_QUADS);
+            rlColor4ub(255, 255, 255, 255);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+
+            for (u32 i = start; i < end; i++)
+            {
+                const auto &quad = quads[i];
+
+                f32 dx = -quad.toWidth / 2;
+                f32 dy = -quad.toHeight / 2;
+                f32 sinRotation = 0.0f;
+                f32 cosRotation = 1.0f;
+
+                if (quad.rotate != 0.0f)
+                {
+                    sinRotation = std::sin(quad.rotate * DEG2RAD);
+                    cosRotation = std::cos(quad.rotate * DEG2RAD);
+                }
+
+                auto corner = [&](f32 x, f32 y) -> ::Vector2
+                {
+                    return ::Vector2{quad.toX + x * cosRotation - y * sinRotation,
+                                     quad.toY + x * sinRotation + y * cosRotation};
+                };
+
+                ::Vector2 topLeft = corner(dx, dy);
+                ::Vector2 topRight = corner(dx + quad.toWidth, dy);
+                ::Vector2 bottomLeft = corner(dx, dy + quad.toHeight);
+                ::Vector2 bottomRight = corner(dx + quad.toWidth, dy + quad.toHeight);
+
+                f32 left = quad.fromX / width;
+                f32 right = (quad.fromX + quad.fromWidth) / width;
+                f32 top = quad.fromY / height;
+                f32 bottom = (quad.fromY + quad.fromHeight) / height;
+
+                rlTexCoord2f(left, top);
+                rlVertex2f(topLeft.x, topLeft.y);
+                rlTexCoord2f(left, bottom);
+                rlVertex2f(bottomLeft.x, bottomLeft.y);
+                rlTexCoord2f(right, bottom);
+                rlVertex2f(bottomRight.x, bottomRight.y);
+                rlTexCoord2f(right, top);
+                rlVertex2f(topRight.x, topRight.y);
+            }
+
+            rlEnd();
+            rlSetTexture(0);
+        }
+    }
+
     void RaylibGraphicAPI::DrawNoFillRectangle(
         f32 x, f32 y,
         f32 width,
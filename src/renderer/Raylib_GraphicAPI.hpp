@@ -14,6 +14,14 @@ namespace ntt
         void UnloadTexture(Texture2D texture) override;
         b8 IsLoadedSuccess(Texture2D texture) override;
 
+        Image LoadImage(const String &path) override;
+        void UnloadImage(Image image) override;
+        Size LoadImageSize(const String &path) override;
+        Texture2D LoadTextureFromImage(Image image) override;
+        Texture2D LoadAtlasTexture(u32 width,
+                                   u32 height,
+                                   const List<AtlasImage> &images) override;
+
         void DrawText(
             const String &text,
             f32 x,
@@ -43,6 +51,10 @@ namespace ntt
                          f32 th,
                          f32 rotate) override;
 
+        void DrawTextureBatch(Texture2D texture,
+                              const TextureQuad *quads,
+                              u32 count) override;
+
         void DrawNoFillRectangle(f32 x, f32 y, f32 width, f32 height, const RGBAColor &color) override;
 
         void DrawLine(f32 startX, f32 startY,
@@ -73,30 +73,27 @@ namespace ntt
     void RenderSystem::Update(f32 delta, entity_id_t id)
     {
         PROFILE_FUNCTION();
-        auto geo = ECS_GET_COMPONENT(id, Geometry);
-        auto texture = ECS_GET_COMPONENT(id, TextureComponent);
-        auto text = ECS_GET_COMPONENT(id, Text);
-        auto line = ECS_GET_COMPONENT(id, Line);
+        auto geo = ECS_READ_COMPONENT(id, Geometry);
+        auto texture = ECS_READ_COMPONENT(id, TextureComponent);
+        auto text = ECS_READ_COMPONENT(id, Text);
+        auto line = ECS_READ_COMPONENT(id, Line);
 
         RectContext context;
         Grid cell;
         auto drawContext = DrawContext();
 
-        auto windowSize = GetWindowSize();
-
         if (geo == nullptr)
         {
             return;
         }
 
+        auto pos = geo->GetDrawnPos();
+
         if (!m_impl->editor)
         {
-            // check if the texture is in the window or not
-            // if not, then don't draw it
-            if (geo->pos.x + geo->size.width / 2 < 0 ||
-                geo->pos.x - geo->size.width / 2 > windowSize.width ||
-                geo->pos.y + geo->size.height / 2 < 0 ||
-                geo->pos.y - geo->size.height / 2 > windowSize.height)
+            // the objects which are outside of all camera views are not
+            //      submitted (the camera position and zoom are considered)
+            if (!IsInCameraView(pos, geo->size, geo->GetDrawnRotation()))
             {
                 return;
             }
@@ -107,9 +104,9 @@ namespace ntt
 
         if (texture != nullptr)
         {
-            context.position = geo->pos;
+            context.position = pos;
             context.size = geo->size;
-            context.rotate = geo->rotation;
+            context.rotate = geo->GetDrawnRotation();
 
             cell.row = texture->currentCell.row;
             cell.col = texture->currentCell.col;
@@ -123,7 +120,7 @@ namespace ntt
             drawContext.fontSize = text->fontSize;
             drawContext.color = geo->color;
 
-            DrawText(text->text, {geo->pos.x, geo->pos.y}, drawContext);
+            DrawText(text->text, pos, drawContext);
         }
         else if (line != nullptr)
         {
@@ -135,9 +132,9 @@ namespace ntt
         }
         else
         {
-            context.position = geo->pos;
+            context.position = pos;
             context.size = geo->size;
-            context.rotate = geo->rotation;
+            context.rotate = geo->GetDrawnRotation();
 
             drawContext.color = geo->color;
 
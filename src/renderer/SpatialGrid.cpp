@@ -0,0 +1,177 @@
+#include "SpatialGrid.hpp"
+#include <NTTEngine/core/profiling.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ntt
+{
+    SpatialGrid::SpatialGrid(f32 cellSize)
+        : m_cellSize(cellSize)
+    {
+    }
+
+    void SpatialGrid::Clear()
+    {
+        PROFILE_FUNCTION();
+
+        for (auto cell : m_usedCells)
+        {
+            cell->clear();
+        }
+
+        m_usedCells.clear();
+        m_largeItems.clear();
+    }
+
+    i32 SpatialGrid::CellIndex(f32 position) const
+    {
+        return static_cast<i32>(std::floor(position / m_cellSize));
+    }
+
+    f64 SpatialGrid::CellsCount(f32 left, f32 top, f32 right, f32 bottom) const
+    {
+        // the coordinates which do not fit into the cell indexes are counted
+        //      as an infinite rectangle
+        if (!(std::fabs(left) < SPATIAL_MAX_COORDINATE && std::fabs(right) < SPATIAL_MAX_COORDINATE &&
+              std::fabs(top) < SPATIAL_MAX_COORDINATE && std::fabs(bottom) < SPATIAL_MAX_COORDINATE))
+        {
+            return std::numeric_limits<f64>::infinity();
+        }
+
+        return static_cast<f64>(CellIndex(right) - CellIndex(left) + 1) *
+               static_cast<f64>(CellIndex(bottom) - CellIndex(top) + 1);
+    }
+
+    u64 SpatialGrid::CellKey(i32 x, i32 y) const
+    {
+        return (static_cast<u64>(static_cast<u32>(x)) << 32) | static_cast<u32>(y);
+    }
+
+    void SpatialGrid::Insert(u32 item, f32 left, f32 top, f32 right, f32 bottom)
+    {
+        if (item >= m_bounds.size())
+        {
+            m_bounds.resize(item + 1);
+            m_marks.resize(item + 1, 0);
+        }
+
+        m_bounds[item] = {left, top, right, bottom};
+
+        if (CellsCount(left, top, right, bottom) > SPATIAL_MAX_CELLS)
+        {
+            m_largeItems.push_back(item);
+            return;
+        }
+
+        i32 firstX = CellIndex(left);
+        i32 lastX = CellIndex(right);
+        i32 firstY = CellIndex(top);
+        i32 lastY = CellIndex(bottom);
+
+        for (i32 y = firstY; y <= lastY; y++)
+        {
+            for (i32 x = firstX; x <= lastX; x++)
+            {
+                auto &cell = m_cells[CellKey(x, y)];
+
+                if (cell.empty())
+                {
+                    m_usedCells.push_back(&cell);
+                }
+
+                cell.push_back(item);
+            }
+        }
+    }
+
+    void SpatialGrid::InsertUnbounded(u32 item)
+    {
+        constexpr f32 infinity = std::numeric_limits<f32>::infinity();
+
+        if (item >= m_bounds.size())
+        {
+            m_bounds.resize(item + 1);
+            m_marks.resize(item + 1, 0);
+        }
+
+        m_bounds[item] = {-infinity, -infinity, infinity, infinity};
+        m_largeItems.push_back(item);
+    }
+
+    void SpatialGrid::Mark(u32 item)
+    {
+        m_marks[item] = m_queryStamp;
+    }
+
+    void SpatialGrid::Query(f32 left, f32 top, f32 right, f32 bottom, List<u32> &result)
+    {
+        PROFILE_FUNCTION();
+
+        m_queryStamp++;
+
+        if (m_queryStamp == 0)
+        {
+            std::fill(m_marks.begin(), m_marks.end(), 0);
+            m_queryStamp = 1;
+        }
+
+        auto overlaps = [&](u32 item) -> b8
+        {
+            const auto &bounds = m_bounds[item];
+            return bounds.left <= right && left <= bounds.right &&
+                   bounds.top <= bottom && top <= bounds.bottom;
+        };
+
+        for (auto item : m_largeItems)
+        {
+            if (overlaps(item))
+            {
+                Mark(item);
+                result.push_back(item);
+            }
+        }
+
+        auto collect = [&](const List<u32> &cell)
+        {
+            for (auto item : cell)
+            {
+                if (m_marks[item] != m_queryStamp && overlaps(item))
+                {
+                    Mark(item);
+                    result.push_back(item);
+                }
+            }
+        };
+
+        // a large rectangle (a zoomed out camera) is checked against the used
+        //      cells instead of looking up every cell of the rectangle
+        if (CellsCount(left, top, right, bottom) > static_cast<f64>(m_usedCells.size()))
+        {
+            for (auto cell : m_usedCells)
+            {
+                collect(*cell);
+            }
+
+            return;
+        }
+
+        i32 firstX = CellIndex(left);
+        i32 lastX = CellIndex(right);
+        i32 firstY = CellIndex(top);
+        i32 lastY = CellIndex(bottom);
+
+        for (i32 y = firstY; y <= lastY; y++)
+        {
+            for (i32 x = firstX; x <= lastX; x++)
+            {
+                auto it = m_cells.find(CellKey(x, y));
+
+                if (it != m_cells.end())
+                {
+                    collect(it->second);
+                }
+            }
+        }
+    }
+} // namespace ntt
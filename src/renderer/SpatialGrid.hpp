@@ -0,0 +1,69 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <unordered_map>
+
+namespace ntt
+{
+#define SPATIAL_CELL_SIZE 256.0f ///< The size of a grid cell in the world space
+#define SPATIAL_MAX_CELLS 64     ///< The items which cover more cells are kept in a separate list
+#define SPATIAL_MAX_COORDINATE 1.0e8f ///< The items which are further are kept in a separate list
+
+    /**
+     * The uniform grid over the bounds of the items (the indexes of the draw
+     *      commands), it's rebuilt every frame, so the cells keep their memory
+     *      when the grid is cleared. The item is stored in every cell it
+     *      overlaps, the queries return each item once.
+     */
+    class SpatialGrid
+    {
+    public:
+        SpatialGrid(f32 cellSize = SPATIAL_CELL_SIZE);
+
+        /**
+         * Remove all the items (the memory of the cells is kept)
+         */
+        void Clear();
+
+        void Insert(u32 item, f32 left, f32 top, f32 right, f32 bottom);
+
+        /**
+         * Insert the item which has no bounds (like a text), it's returned
+         *      by every query
+         */
+        void InsertUnbounded(u32 item);
+
+        /**
+         * Append all the items which overlap the rectangle (the borders are
+         *      included) to the result, the order of the items is not defined
+         */
+        void Query(f32 left, f32 top, f32 right, f32 bottom, List<u32> &result);
+
+        inline void QueryPoint(f32 x, f32 y, List<u32> &result) { Query(x, y, x, y, result); }
+
+    private:
+        struct Bounds
+        {
+            f32 left;
+            f32 top;
+            f32 right;
+            f32 bottom;
+        };
+
+        i32 CellIndex(f32 position) const;
+        f64 CellsCount(f32 left, f32 top, f32 right, f32 bottom) const;
+        u64 CellKey(i32 x, i32 y) const;
+        void Mark(u32 item);
+
+        f32 m_cellSize;
+        std::unordered_map<u64, List<u32>> m_cells;
+        List<List<u32> *> m_usedCells; ///< The cells which are not empty (the map nodes are stable)
+        List<u32> m_largeItems;        ///< The unbounded items and the items which cover too many cells
+        List<Bounds> m_bounds;         ///< The bounds of each item (indexed by the item)
+
+        // each query stamps the returned items, so the items which are in
+        //      multiple cells are only returned once
+        List<u32> m_marks;
+        u32 m_queryStamp = 0;
+    };
+} // namespace ntt
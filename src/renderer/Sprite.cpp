@@ -3,6 +3,15 @@
 
 namespace ntt
 {
+    Ref<ComponentBase> Sprite::Clone() const
+    {
+        // the timer is not copied, each sprite has its own animation timer
+        auto sprite = CreatePooledRef<Sprite>(cells, changePerMilis);
+        sprite->currentCell = currentCell;
+        sprite->active = active;
+        return sprite;
+    }
+
     String Sprite::GetName() const
     {
         return "Sprite";
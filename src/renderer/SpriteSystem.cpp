@@ -38,27 +38,36 @@ namespace ntt
     }
 
     void SpriteRenderSystem::Update(f32 delta, entity_id_t id)
+    {
+        UpdateBatch(delta, Span<const entity_id_t>(&id, 1));
+    }
+
+    void SpriteRenderSystem::UpdateBatch(f32 delta, Span<const entity_id_t> ids)
     {
         PROFILE_FUNCTION();
-        auto sprite = ECS_GET_COMPONENT(id, Sprite);
-        auto texture = ECS_GET_COMPONENT(id, TextureComponent);
 
-        auto rowIndex = texture->currentCell.row;
-        auto colIndex = texture->currentCell.col;
+        // the components are walked in their columns, the deleted entities are skipped
+        ECSQuery<Sprite, TextureComponent>().ForEach(
+            ids,
+            [](entity_id_t, Sprite &sprite, TextureComponent &texture)
+            {
+                auto rowIndex = texture.currentCell.row;
+                auto colIndex = texture.currentCell.col;
 
-        auto currentCell = sprite->cells[sprite->currentCell];
+                auto currentCell = sprite.cells[sprite.currentCell];
 
-        if (sprite->timer.GetMilliseconds() > sprite->changePerMilis)
-        {
-            sprite->timer.Reset();
-            sprite->currentCell = (sprite->currentCell + 1) % sprite->cells.size();
-        }
+                if (sprite.timer.GetMilliseconds() > sprite.changePerMilis)
+                {
+                    sprite.timer.Reset();
+                    sprite.currentCell = (sprite.currentCell + 1) % sprite.cells.size();
+                }
 
-        if (rowIndex != currentCell.first || rowIndex != currentCell.second)
-        {
-            texture->currentCell.row = currentCell.first;
-            texture->currentCell.col = currentCell.second;
-        }
+                if (rowIndex != currentCell.first || rowIndex != currentCell.second)
+                {
+                    texture.currentCell.row = currentCell.first;
+                    texture.currentCell.col = currentCell.second;
+                }
+            });
     }
 
     void SpriteRenderSystem::ShutdownEntity(entity_id_t id)
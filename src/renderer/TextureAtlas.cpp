@@ -0,0 +1,76 @@
+#include "TextureAtlas.hpp"
+#include <NTTEngine/core/profiling.hpp>
+#include <algorithm>
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imstb_rectpack.h>
+
+namespace ntt
+{
+    AtlasLayout PackAtlas(const List<Size> &sizes, u32 pageSize, u32 padding)
+    {
+        PROFILE_FUNCTION();
+
+        AtlasLayout layout;
+        layout.placements.resize(sizes.size(), {ATLAS_NO_PAGE, 0, 0});
+
+        List<stbrp_rect> rects;
+
+        for (u32 i = 0; i < sizes.size(); i++)
+        {
+            u32 width = static_cast<u32>(sizes[i].width) + padding * 2;
+            u32 height = static_cast<u32>(sizes[i].height) + padding * 2;
+
+            if (width > pageSize || height > pageSize)
+            {
+                continue;
+            }
+
+            stbrp_rect rect = {};
+            rect.id = static_cast<i32>(i);
+            rect.w = static_cast<stbrp_coord>(width);
+            rect.h = static_cast<stbrp_coord>(height);
+            rects.push_back(rect);
+        }
+
+        List<stbrp_node> nodes;
+        nodes.resize(pageSize);
+
+        // every rectangle fits into an empty page, so each page packs at
+        //      least one of the remaining rectangles
+        while (!rects.empty())
+        {
+            stbrp_context context;
+            stbrp_init_target(&context, pageSize, pageSize, nodes.data(), nodes.size());
+            stbrp_pack_rects(&context, rects.data(), rects.size());
+
+            u32 page = layout.pages.size();
+            u32 pageWidth = 0;
+            u32 pageHeight = 0;
+            List<stbrp_rect> remainingRects;
+
+            for (auto &rect : rects)
+            {
+                if (!rect.was_packed)
+                {
+                    remainingRects.push_back(rect);
+                    continue;
+                }
+
+                layout.placements[rect.id] = {page,
+                                              static_cast<u32>(rect.x) + padding,
+                                              static_cast<u32>(rect.y) + padding};
+
+                pageWidth = std::max(pageWidth, static_cast<u32>(rect.x + rect.w));
+                pageHeight = std::max(pageHeight, static_cast<u32>(rect.y + rect.h));
+            }
+
+            layout.pages.push_back(Size(static_cast<ntt_size_t>(pageWidth),
+                                        static_cast<ntt_size_t>(pageHeight)));
+            rects.swap(remainingRects);
+        }
+
+        return layout;
+    }
+} // namespace ntt
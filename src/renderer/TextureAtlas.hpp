@@ -0,0 +1,37 @@
+#pragma once
+#include <NTTEngine/defines.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <NTTEngine/structures/size.hpp>
+
+namespace ntt
+{
+#define ATLAS_NO_PAGE u32(-1) ///< The page of the images which can not be packed
+
+    /**
+     * The position of an image in the atlas pages
+     */
+    struct AtlasPlacement
+    {
+        u32 page; ///< The index of the page, ATLAS_NO_PAGE if the image is too large
+        u32 x;
+        u32 y;
+    };
+
+    struct AtlasLayout
+    {
+        List<AtlasPlacement> placements; ///< The placements in the order of the input sizes
+        List<Size> pages;                ///< The used size of each page (at most the page size)
+    };
+
+    /**
+     * Pack the images into as few square pages as possible (with stb_rect_pack),
+     *      a page is only started when the images do not fit into the previous
+     *      ones. The images are separated by the padding, so the neighbour
+     *      images are not sampled at the edges.
+     *
+     * @param sizes The sizes of the images (in pixels)
+     * @param pageSize The maximum width and height of a page
+     * @param padding The empty pixels around each image
+     */
+    AtlasLayout PackAtlas(const List<Size> &sizes, u32 pageSize, u32 padding);
+} // namespace ntt
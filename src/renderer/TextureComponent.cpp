@@ -16,6 +16,11 @@ namespace ntt
         return resourceName;
     }
 
+    Ref<ComponentBase> TextureComponent::Clone() const
+    {
+        return CreatePooledRef<TextureComponent>(*this);
+    }
+
     String TextureComponent::GetName() const
     {
         return "TextureComponent";
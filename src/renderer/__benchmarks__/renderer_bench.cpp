@@ -0,0 +1,76 @@
+#include <NTTEngine/dev/benchmark.hpp>
+
+#include <NTTEngine/application/input_system/input_system.hpp>
+#include <NTTEngine/renderer/renderer.hpp>
+#include <NTTEngine/renderer/GraphicInterface.hpp>
+
+using namespace ntt;
+
+NTT_BENCHMARK(DrawTextureSubmit, 1000, 10000)
+{
+    InputInit(TRUE);
+    RendererInit(TRUE);
+    AddCamera(Position{400, 300}, Size{800, 600});
+
+    List<resource_id_t> textures;
+
+    for (u32 i = 0; i < 8; i++)
+    {
+        textures.push_back(LoadTexture(format("texture_{}", i)));
+    }
+
+    bench.SetItemsCount(bench.Argument());
+    bench.Run(
+        [&]()
+        {
+            for (u32 i = 0; i < bench.Argument(); i++)
+            {
+                DrawContext context;
+                context.priority = i % 5;
+                context.entity_id = i;
+
+                DrawTexture(
+                    textures[i % textures.size()],
+                    {{static_cast<f32>(i % 800), static_cast<f32>(i / 800 % 600)}, {16, 16}},
+                    {0, 0},
+                    context);
+            }
+
+            GraphicUpdate();
+        });
+
+    RendererShutdown();
+    InputShutdown();
+}
+
+NTT_BENCHMARK(DrawTextureCulled, 1000, 10000)
+{
+    InputInit(TRUE);
+    RendererInit(TRUE);
+    AddCamera(Position{400, 300}, Size{800, 600});
+
+    auto texture = LoadTexture("texture");
+
+    bench.SetItemsCount(bench.Argument());
+    bench.Run(
+        [&]()
+        {
+            // only about 1/16 of the sprites are inside the camera view
+            for (u32 i = 0; i < bench.Argument(); i++)
+            {
+                DrawContext context;
+                context.entity_id = i;
+
+                DrawTexture(
+                    texture,
+                    {{static_cast<f32>(i % 3200), static_cast<f32>(i / 3200 % 40 * 60)}, {16, 16}},
+                    {0, 0},
+                    context);
+            }
+
+            GraphicUpdate();
+        });
+
+    RendererShutdown();
+    InputShutdown();
+}
@@ -91,6 +91,31 @@ TEST_F(GraphicInterfaceTest, DrawTextAndTextureWithRightPriority)
     EXPECT_NO_THROW(UnloadTexture(texture));
 }
 
+TEST_F(GraphicInterfaceTest, CommandsAreDrawnByEveryCameraOnce)
+{
+    AddCamera(Position{0, 0}, Size{100, 100});
+
+    DrawContext context;
+    context.priority = 2;
+    DrawText("Score", {0, 0}, context);
+
+    context.priority = 1;
+    DrawText("Background", {0, 0}, context);
+
+    context.priority = 255; // out of range priority
+    DrawText("Ignored", {0, 0}, context);
+
+    GraphicUpdate();
+
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTexts,
+              List<String>({"Background", "Score", "Background", "Score"}));
+
+    // the commands of the previous frame are not drawn again
+    GraphicUpdate();
+
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextCalled, 4);
+}
+
 TEST_F(GraphicInterfaceTest, ValidateSizeTest)
 {
     FakeGraphicAPI::s_instance->m_expectedTexture = Texture2D(nullptr, 100, 200);
@@ -172,4 +197,277 @@ TEST_F(GraphicInterfaceTest, HoveringWithMultipleEntity)
             "Entity 1",
             "Entity 8",
         }));
-}
\ No newline at end of file
+}
+TEST_F(GraphicInterfaceTest, SpritesWithTheSameTextureAreBatched)
+{
+    auto tiles = LoadTexture("tiles");
+    auto characters = LoadTexture("characters");
+
+    DrawContext context;
+    context.priority = 1;
+
+    for (u32 i = 0; i < 3; i++)
+    {
+        DrawTexture(tiles, {{0, 0}, {10, 10}}, {0, 0}, context);
+        DrawTexture(characters, {{0, 0}, {10, 10}}, {0, 0}, context);
+    }
+
+    DrawText("Title", {0, 0}, context);
+    DrawTexture(tiles, {{0, 0}, {10, 10}}, {0, 0}, context);
+
+    context.priority = 2;
+    DrawTexture(tiles, {{0, 0}, {10, 10}}, {0, 0}, context);
+
+    GraphicUpdate();
+
+    // the sprite after the text is not moved under it
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureCalled, 8);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureBatchCalled, 4);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextCalled, 1);
+
+    auto stats = GetRendererStats();
+    EXPECT_EQ(stats.drawCommands, 9);
+    EXPECT_EQ(stats.textureBatches, 4);
+    EXPECT_EQ(stats.textureSwitches, 3);
+    EXPECT_EQ(stats.drawCalls, 6); // 4 batches, the text and the camera frame
+}
+
+TEST_F(GraphicInterfaceTest, RectanglesKeepTheirOrderWithTheSprites)
+{
+    auto tiles = LoadTexture("tiles");
+    auto characters = LoadTexture("characters");
+
+    DrawContext context;
+    context.priority = 1;
+
+    DrawRectangle({{0, 0}, {50, 50}}, context);
+    DrawTexture(tiles, {{0, 0}, {10, 10}}, {0, 0}, context);
+    DrawTexture(characters, {{0, 0}, {10, 10}}, {0, 0}, context);
+    DrawTexture(tiles, {{0, 0}, {10, 10}}, {0, 0}, context);
+    DrawRectangle({{0, 0}, {20, 20}}, context);
+    DrawTexture(tiles, {{0, 0}, {10, 10}}, {0, 0}, context);
+
+    GraphicUpdate();
+
+    // the sprites are only batched between the rectangles
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawCalls,
+              List<String>({"rectangle", "texture", "texture", "rectangle", "texture"}));
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureCalled, 4);
+    EXPECT_EQ(GetRendererStats().textureBatches, 3);
+}
+
+TEST_F(GraphicInterfaceTest, AtlasImagesShareTheTextureBatch)
+{
+    FakeGraphicAPI::s_instance->m_expectedTexture = Texture2D(nullptr, 32, 16);
+
+    LoadTextureAtlas({"tiles", "characters"});
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_loadAtlasTextureCalled, 1);
+
+    auto tiles = LoadTexture("tiles", {1, 2});
+    auto characters = LoadTexture("characters");
+
+    auto size = ValidateSize(tiles, {{}, {SIZE_DEFAULT, SIZE_DEFAULT}});
+    EXPECT_EQ(size.first, (Size{16, 16}));
+    EXPECT_EQ(size.second, (Size{32, 16}));
+
+    DrawContext context;
+    DrawTexture(tiles, {{0, 0}, {10, 10}}, {0, 1}, context);
+    DrawTexture(characters, {{0, 0}, {10, 10}}, {0, 0}, context);
+    DrawTexture(tiles, {{0, 0}, {10, 10}}, {0, 0}, context);
+
+    GraphicUpdate();
+
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureCalled, 3);
+    EXPECT_EQ(GetRendererStats().textureBatches, 1);
+
+    UnloadTexture(tiles);
+    UnloadTexture(characters);
+
+    // the page is unloaded, the images are loaded as separate textures
+    auto separated = LoadTexture("tiles");
+    DrawTexture(separated, {{0, 0}, {10, 10}}, {0, 0}, context);
+    DrawTexture(LoadTexture("characters"), {{0, 0}, {10, 10}}, {0, 0}, context);
+
+    GraphicUpdate();
+    EXPECT_EQ(GetRendererStats().textureBatches, 2);
+}
+
+TEST_F(GraphicInterfaceTest, AsyncTextureIsUsableBeforeItsUpload)
+{
+    FakeGraphicAPI::s_instance->m_expectedTexture = Texture2D(nullptr, 32, 16);
+
+    auto texture = LoadTexture("hero", {1, 2}, TRUE);
+    EXPECT_EQ(GetLoadingTexturesCount(), 1);
+
+    // the size is known before the image is decoded
+    auto size = ValidateSize(texture, {{}, {SIZE_DEFAULT, SIZE_DEFAULT}});
+    EXPECT_EQ(size.first, (Size{16, 16}));
+    EXPECT_EQ(size.second, (Size{32, 16}));
+
+    DrawContext context;
+    DrawTexture(texture, {{0, 0}, {10, 10}}, {0, 0}, context);
+    GraphicUpdate();
+
+    // the placeholder is drawn, the image is uploaded for the next frame
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureCalled, 0);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawRectangleProCalled, 1);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_loadTextureFromImageCalled, 1);
+    EXPECT_EQ(GetLoadingTexturesCount(), 0);
+
+    DrawTexture(texture, {{0, 0}, {10, 10}}, {0, 0}, context);
+    GraphicUpdate();
+
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureCalled, 1);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawRectangleProCalled, 1);
+}
+
+TEST_F(GraphicInterfaceTest, AsyncUploadsAreSpreadOverFrames)
+{
+    FakeGraphicAPI::s_instance->m_expectedTexture = Texture2D(nullptr, 2048, 2048);
+
+    LoadTexture("background", {1, 1}, TRUE);
+    auto removed = LoadTexture("sky", {1, 1}, TRUE);
+    LoadTexture("ground", {1, 1}, TRUE);
+
+    UnloadTexture(removed);
+    EXPECT_EQ(GetLoadingTexturesCount(), 2);
+
+    GraphicUpdate();
+    EXPECT_EQ(GetLoadingTexturesCount(), 1);
+
+    // the image of the unloaded texture is dropped without an upload
+    GraphicUpdate();
+    EXPECT_EQ(GetLoadingTexturesCount(), 0);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_loadTextureFromImageCalled, 2);
+}
+
+TEST_F(GraphicInterfaceTest, AsyncAtlasPageIsUploadedWhenComplete)
+{
+    FakeGraphicAPI::s_instance->m_expectedTexture = Texture2D(nullptr, 32, 16);
+
+    LoadTextureAtlas({"tiles", "characters"}, TRUE);
+    auto tiles = LoadTexture("tiles", {1, 1}, TRUE);
+    auto characters = LoadTexture("characters", {1, 1}, TRUE);
+
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_loadAtlasTextureCalled, 0);
+    EXPECT_EQ(GetLoadingTexturesCount(), 2);
+
+    GraphicUpdate();
+
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_loadAtlasTextureCalled, 1);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_loadTextureFromImageCalled, 0);
+    EXPECT_EQ(GetLoadingTexturesCount(), 0);
+
+    // the sizes are known before the images are decoded
+    auto size = ValidateSize(tiles, {{}, {SIZE_DEFAULT, SIZE_DEFAULT}});
+    EXPECT_EQ(size.first, (Size{32, 16}));
+    EXPECT_EQ(size.second, (Size{32, 16}));
+
+    DrawContext context;
+    DrawTexture(tiles, {{0, 0}, {SIZE_DEFAULT, SIZE_DEFAULT}}, {0, 0}, context);
+    DrawTexture(characters, {{0, 0}, {SIZE_DEFAULT, SIZE_DEFAULT}}, {0, 0}, context);
+    GraphicUpdate();
+
+    EXPECT_EQ(GetRendererStats().textureBatches, 1);
+
+    const auto &quads = FakeGraphicAPI::s_instance->m_drawnQuads;
+    ASSERT_EQ(quads.size(), 2);
+
+    for (const auto &quad : quads)
+    {
+        EXPECT_EQ(quad.fromWidth, 32);
+        EXPECT_EQ(quad.fromHeight, 16);
+        EXPECT_EQ(quad.toWidth, 32);
+        EXPECT_EQ(quad.toHeight, 16);
+    }
+
+    // the images are placed in different regions of the page
+    EXPECT_TRUE(quads[0].fromX != quads[1].fromX || quads[0].fromY != quads[1].fromY);
+}
+
+TEST_F(GraphicInterfaceTest, FailedDecodesAreResolved)
+{
+    FakeGraphicAPI::s_instance->m_expectedTexture = Texture2D(nullptr, 32, 16);
+    FakeGraphicAPI::s_instance->m_failedPaths = {"recovered", "broken"};
+
+    auto recovered = LoadTexture("recovered", {1, 1}, TRUE);
+    auto broken = LoadTexture("broken", {1, 1}, TRUE);
+    EXPECT_EQ(GetLoadingTexturesCount(), 2);
+
+    // the texture is loaded synchronously after its decode failed
+    FakeGraphicAPI::s_instance->m_failedPaths = {"broken"};
+    GraphicUpdate();
+
+    EXPECT_EQ(GetLoadingTexturesCount(), 0);
+
+    DrawContext context;
+    DrawTexture(recovered, {{0, 0}, {10, 10}}, {0, 0}, context);
+    DrawTexture(broken, {{0, 0}, {10, 10}}, {0, 0}, context);
+    GraphicUpdate();
+
+    // the broken texture is not drawn (not even as the placeholder)
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureCalled, 1);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawRectangleProCalled, 0);
+}
+
+TEST_F(GraphicInterfaceTest, AtlasPageWithAFailedImageIsReleased)
+{
+    FakeGraphicAPI::s_instance->m_expectedTexture = Texture2D(nullptr, 32, 16);
+
+    FakeGraphicAPI::s_instance->m_failedPaths = {"characters"};
+
+    LoadTextureAtlas({"tiles", "characters"}, TRUE);
+    auto tiles = LoadTexture("tiles", {1, 1}, TRUE);
+    auto characters = LoadTexture("characters", {1, 1}, TRUE);
+
+    GraphicUpdate();
+
+    // the page is never uploaded, the working image is loaded on its own
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_loadAtlasTextureCalled, 0);
+    EXPECT_EQ(GetLoadingTexturesCount(), 0);
+
+    DrawContext context;
+    DrawTexture(tiles, {{0, 0}, {SIZE_DEFAULT, SIZE_DEFAULT}}, {0, 0}, context);
+    DrawTexture(characters, {{0, 0}, {SIZE_DEFAULT, SIZE_DEFAULT}}, {0, 0}, context);
+    GraphicUpdate();
+
+    const auto &quads = FakeGraphicAPI::s_instance->m_drawnQuads;
+    ASSERT_EQ(quads.size(), 1);
+    EXPECT_EQ(quads[0].fromX, 0);
+    EXPECT_EQ(quads[0].fromY, 0);
+    EXPECT_EQ(quads[0].fromWidth, 32);
+
+    UnloadTexture(tiles);
+    UnloadTexture(characters);
+}
+
+TEST_F(GraphicInterfaceTest, CommandsOutsideOfTheCameraViewAreCulled)
+{
+    auto camera = GetCameraInfo(0)->camera;
+    auto texture = LoadTexture("tiles");
+
+    DrawContext context;
+    DrawTexture(texture, {{50, 50}, {10, 10}}, {0, 0}, context);
+    DrawTexture(texture, {{1000, 50}, {10, 10}}, {0, 0}, context);
+    DrawRectangle({{-500, -500}, {10, 10}}, context);
+    DrawText("Score", {2000, 2000}, context);
+
+    GraphicUpdate();
+
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureCalled, 1);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawRectangleProCalled, 0);
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextCalled, 1);
+    EXPECT_EQ(GetRendererStats().culledCommands, 2);
+
+    // the camera is moved to the second texture
+    camera->camPos.x = -900;
+    EXPECT_TRUE(IsInCameraView({1000, 50}, {10, 10}));
+    EXPECT_FALSE(IsInCameraView({50, 50}, {10, 10}));
+
+    DrawTexture(texture, {{50, 50}, {10, 10}}, {0, 0}, context);
+    DrawTexture(texture, {{1000, 50}, {10, 10}}, {0, 0}, context);
+    GraphicUpdate();
+
+    EXPECT_EQ(FakeGraphicAPI::s_instance->m_drawTextureCalled, 2);
+    EXPECT_EQ(GetRendererStats().culledCommands, 1);
+}
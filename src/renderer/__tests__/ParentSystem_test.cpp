@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <NTTEngine/ecs/ecs.hpp>
+#include <NTTEngine/ecs/ecs_query.hpp>
+#include <NTTEngine/application/event_system/event_system.hpp>
+#include <NTTEngine/renderer/Geometry.hpp>
+#include <NTTEngine/renderer/Parent.hpp>
+#include <NTTEngine/renderer/ParentSystem.hpp>
+
+using namespace ntt;
+
+class ParentSystemTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        EventInit();
+        ECSInit();
+
+        ECSRegister(
+            "Parent System",
+            CreateRef<ParentSystem>(),
+            {typeid(Parent)},
+            FALSE,
+            SystemAccess({typeid(Parent), typeid(Geometry)}, {typeid(Geometry)}));
+
+        ECSBeginLayer(GAME_LAYER);
+        ECSLayerMakeVisible(GAME_LAYER);
+    }
+
+    void TearDown() override
+    {
+        ECSShutdown();
+        EventShutdown();
+    }
+
+    Ref<const Geometry> GetGeometry(entity_id_t id)
+    {
+        return ECS_READ_COMPONENT(id, Geometry);
+    }
+};
+
+TEST_F(ParentSystemTest, NestedChildrenAreResolvedInOneUpdate)
+{
+    auto root = ECSCreateEntity("root", {ECS_CREATE_COMPONENT(Geometry, 100, 100)});
+
+    // the grandchild is created before its parent, so the update order of
+    //      the entities does not follow the hierarchy
+    auto grandChild = ECSCreateEntity(
+        "grand-child",
+        {ECS_CREATE_COMPONENT(Geometry), ECS_CREATE_COMPONENT(Parent)});
+    auto child = ECSCreateEntity(
+        "child",
+        {ECS_CREATE_COMPONENT(Geometry), ECS_CREATE_COMPONENT(Parent, root, 10, 0, 90)});
+    ECS_GET_COMPONENT(grandChild, Parent)->parentId = child;
+    ECS_GET_COMPONENT(grandChild, Parent)->relPos = {5, 0};
+
+    ECSUpdate(0.0f);
+
+    EXPECT_NEAR(GetGeometry(child)->pos.x, 110, 0.01);
+    EXPECT_NEAR(GetGeometry(child)->pos.y, 100, 0.01);
+    EXPECT_NEAR(GetGeometry(child)->rotation, 90, 0.01);
+
+    // the child is rotated, so the grandchild is placed below it
+    EXPECT_NEAR(GetGeometry(grandChild)->pos.x, 110, 0.01);
+    EXPECT_NEAR(GetGeometry(grandChild)->pos.y, 105, 0.01);
+    EXPECT_NEAR(GetGeometry(grandChild)->rotation, 90, 0.01);
+
+    ECS_GET_COMPONENT(root, Geometry)->pos = {0, 0};
+    ECSUpdate(0.0f);
+
+    EXPECT_NEAR(GetGeometry(child)->pos.x, 10, 0.01);
+    EXPECT_NEAR(GetGeometry(grandChild)->pos.x, 10, 0.01);
+    EXPECT_NEAR(GetGeometry(grandChild)->pos.y, 5, 0.01);
+}
+
+TEST_F(ParentSystemTest, OnlyMovedBranchesAreRecomputed)
+{
+    auto movedRoot = ECSCreateEntity("moved-root", {ECS_CREATE_COMPONENT(Geometry, 0, 0)});
+    auto staticRoot = ECSCreateEntity("static-root", {ECS_CREATE_COMPONENT(Geometry, 50, 50)});
+
+    auto movedChild = ECSCreateEntity(
+        "moved-child",
+        {ECS_CREATE_COMPONENT(Geometry), ECS_CREATE_COMPONENT(Parent, movedRoot, 1, 1)});
+    auto staticChild = ECSCreateEntity(
+        "static-child",
+        {ECS_CREATE_COMPONENT(Geometry), ECS_CREATE_COMPONENT(Parent, staticRoot, 1, 1)});
+
+    ECSUpdate(0.0f);
+    ECSUpdate(0.0f);
+
+    u32 since = ECSGetChangeTick();
+    ECS_GET_COMPONENT(movedRoot, Geometry)->pos = {20, 20};
+    ECSUpdate(0.0f);
+
+    EXPECT_TRUE(ECSIsComponentChanged(movedChild, typeid(Geometry), since));
+    EXPECT_FALSE(ECSIsComponentChanged(staticChild, typeid(Geometry), since));
+
+    EXPECT_NEAR(GetGeometry(movedChild)->pos.x, 21, 0.01);
+    EXPECT_NEAR(GetGeometry(staticChild)->pos.x, 51, 0.01);
+
+    // replacing the parent moves the child to the new parent
+    ECS_GET_COMPONENT(staticChild, Parent)->parentId = movedRoot;
+    ECSUpdate(0.0f);
+
+    EXPECT_NEAR(GetGeometry(staticChild)->pos.x, 21, 0.01);
+    EXPECT_NEAR(GetGeometry(staticChild)->pos.y, 21, 0.01);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "../SpatialGrid.hpp"
+
+using namespace ntt;
+using namespace ::testing;
+
+TEST(SpatialGridTest, QueryReturnsOverlappingItemsOnce)
+{
+    SpatialGrid grid(100);
+
+    grid.Insert(0, 10, 10, 20, 20);
+    grid.Insert(1, 50, 50, 250, 250); // in multiple cells
+    grid.Insert(2, 500, 500, 510, 510);
+    grid.Insert(3, -150, -150, -120, -120);
+    grid.InsertUnbounded(4);
+
+    List<u32> result;
+    grid.Query(0, 0, 200, 200, result);
+    EXPECT_THAT(result, UnorderedElementsAre(0, 1, 4));
+
+    result.clear();
+    grid.QueryPoint(-130, -130, result);
+    EXPECT_THAT(result, UnorderedElementsAre(3, 4));
+
+    // the item is in the cell, but it does not contain the point
+    result.clear();
+    grid.QueryPoint(30, 30, result);
+    EXPECT_THAT(result, UnorderedElementsAre(4));
+
+    // a very large rectangle checks the used cells only
+    result.clear();
+    grid.Query(-1.0e7f, -1.0e7f, 1.0e7f, 1.0e7f, result);
+    EXPECT_THAT(result, UnorderedElementsAre(0, 1, 2, 3, 4));
+
+    grid.Clear();
+    result.clear();
+    grid.Query(0, 0, 1000, 1000, result);
+    EXPECT_TRUE(result.empty());
+}
+
+TEST(SpatialGridTest, LargeItemsAreAlwaysChecked)
+{
+    SpatialGrid grid(10);
+
+    grid.Insert(0, 0, 0, 1000, 1000);
+    grid.Insert(1, 2000, 2000, 2005, 2005);
+
+    List<u32> result;
+    grid.QueryPoint(999, 999, result);
+    EXPECT_THAT(result, ElementsAre(0));
+
+    result.clear();
+    grid.QueryPoint(1500, 1500, result);
+    EXPECT_TRUE(result.empty());
+}
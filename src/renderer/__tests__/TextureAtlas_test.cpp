@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "../TextureAtlas.hpp"
+
+using namespace ntt;
+
+TEST(TextureAtlasTest, ImagesArePackedWithoutOverlapping)
+{
+    List<Size> sizes = {{30, 20}, {10, 10}, {64, 64}, {5, 40}};
+
+    auto layout = PackAtlas(sizes, 128, 1);
+
+    ASSERT_EQ(layout.pages.size(), 1);
+    ASSERT_EQ(layout.placements.size(), sizes.size());
+
+    for (u32 i = 0; i < sizes.size(); i++)
+    {
+        auto &first = layout.placements[i];
+        EXPECT_EQ(first.page, 0);
+        EXPECT_GE(first.x, 1);
+        EXPECT_GE(first.y, 1);
+        EXPECT_LE(first.x + sizes[i].width + 1, layout.pages[0].width);
+        EXPECT_LE(first.y + sizes[i].height + 1, layout.pages[0].height);
+
+        for (u32 j = i + 1; j < sizes.size(); j++)
+        {
+            auto &second = layout.placements[j];
+            b8 separated = first.x + sizes[i].width + 2 <= second.x ||
+                           second.x + sizes[j].width + 2 <= first.x ||
+                           first.y + sizes[i].height + 2 <= second.y ||
+                           second.y + sizes[j].height + 2 <= first.y;
+            EXPECT_TRUE(separated) << "images " << i << " and " << j;
+        }
+    }
+}
+
+TEST(TextureAtlasTest, ImagesAreSplitIntoPages)
+{
+    List<Size> sizes = {{60, 60}, {60, 60}, {60, 60}, {60, 60}, {60, 60}, {200, 10}};
+
+    auto layout = PackAtlas(sizes, 128, 2);
+
+    EXPECT_EQ(layout.pages.size(), 2);
+
+    u32 firstPageImages = 0;
+
+    for (u32 i = 0; i < 5; i++)
+    {
+        EXPECT_NE(layout.placements[i].page, ATLAS_NO_PAGE);
+        firstPageImages += layout.placements[i].page == 0 ? 1 : 0;
+    }
+
+    EXPECT_EQ(firstPageImages, 4);
+
+    // too large for a page
+    EXPECT_EQ(layout.placements[5].page, ATLAS_NO_PAGE);
+}
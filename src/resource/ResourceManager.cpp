@@ -7,6 +7,7 @@
 #include <NTTEngine/application/event_system/event_system.hpp>
 
 #include <NTTEngine/renderer/ImageResource.hpp>
+#include <NTTEngine/renderer/GraphicInterface.hpp>
 #include <NTTEngine/audio/AudioResource.hpp>
 #include <NTTEngine/platforms/path.hpp>
 #include <NTTEngine/core/profiling.hpp>
@@ -40,6 +41,40 @@ namespace ntt
     {
         PROFILE_FUNCTION();
 
+        // the images which are loaded together are packed into the atlases,
+        //      an image can opt out with the "atlas": false additional info,
+        //      the images which are loaded synchronously ("async": false)
+        //      are packed into their own pages
+        List<String> atlasPaths;
+        List<String> syncAtlasPaths;
+
+        for (const auto &info : infos)
+        {
+            if (info.type == ResourceType::IMAGE &&
+                !s_resourceIDs.Contains(info.name) &&
+                info.addintionalInfo.Get<b8>("atlas", TRUE))
+            {
+                if (info.addintionalInfo.Get<b8>("async", TRUE))
+                {
+                    atlasPaths.push_back(info.path);
+                }
+                else
+                {
+                    syncAtlasPaths.push_back(info.path);
+                }
+            }
+        }
+
+        if (atlasPaths.size() > 1)
+        {
+            LoadTextureAtlas(atlasPaths, TRUE);
+        }
+
+        if (syncAtlasPaths.size() > 1)
+        {
+            LoadTextureAtlas(syncAtlasPaths);
+        }
+
         for (auto info : infos)
         {
             if (s_resourceIDs.Contains(info.name))
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <NTTEngine/structures/sparse_set.hpp>
+#include <NTTEngine/structures/list.hpp>
+#include <NTTEngine/ecs/component_base.hpp>
+
+using namespace ntt;
+
+class SparseSetTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(SparseSetTest, AddAndContains)
+{
+    SparseSet<u32> set;
+    set.Add(3);
+    set.Add(10);
+    set.Add(0);
+    set.Add(3);
+
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_EQ(set.Values(), List<u32>({3, 10, 0}));
+
+    EXPECT_TRUE(set.Contains(0));
+    EXPECT_TRUE(set.Contains(3));
+    EXPECT_TRUE(set.Contains(10));
+    EXPECT_FALSE(set.Contains(1));
+    EXPECT_FALSE(set.Contains(100));
+}
+
+TEST_F(SparseSetTest, RemoveMovesTheLastItem)
+{
+    SparseSet<u32> set = {1, 2, 3, 4};
+
+    set.RemoveItem(2);
+    EXPECT_EQ(set.Values(), List<u32>({1, 4, 3}));
+    EXPECT_FALSE(set.Contains(2));
+    EXPECT_TRUE(set.Contains(4));
+
+    set.RemoveItem(3);
+    EXPECT_EQ(set.Values(), List<u32>({1, 4}));
+
+    EXPECT_NO_THROW(set.RemoveItem(2));
+    EXPECT_NO_THROW(set.RemoveItem(200));
+    EXPECT_EQ(set.size(), 2);
+
+    set.Add(2);
+    EXPECT_EQ(set.Values(), List<u32>({1, 4, 2}));
+    EXPECT_TRUE(set.Contains(2));
+}
+
+TEST_F(SparseSetTest, Clear)
+{
+    SparseSet<u32> set = {5, 6, 7};
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.Contains(5));
+
+    set.Add(6);
+    EXPECT_EQ(set.Values(), List<u32>({6}));
+
+    u32 count = 0;
+    for (auto item : set)
+    {
+        EXPECT_EQ(item, 6);
+        count++;
+    }
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(SparseSetTest, CustomIndexOf)
+{
+    SparseSet<entity_id_t, EntityIndexOf> set;
+
+    auto oldId = MakeEntityId(3, 0);
+    auto newId = MakeEntityId(3, 1);
+
+    set.Add(oldId);
+    EXPECT_TRUE(set.Contains(oldId));
+    EXPECT_FALSE(set.Contains(newId));
+
+    // the item with the same index replaces the old one
+    set.Add(newId);
+    EXPECT_FALSE(set.Contains(oldId));
+    EXPECT_TRUE(set.Contains(newId));
+    EXPECT_EQ(set.size(), 1);
+
+    set.RemoveItem(oldId);
+    EXPECT_TRUE(set.Contains(newId));
+}